@@ -35,13 +35,16 @@ SOURCES += \
     color.cpp \
     utilities.cpp \
     graphicsscene.cpp \
+    spatialindex.cpp \
     calculator.cpp \
+    solver/calculationservice.cpp \
     widgets/mainwindow.cpp \
     widgets/graphicsview.cpp \
     widgets/lineedit.cpp \
     widgets/seteaiglobaldialog.cpp \
     widgets/settings.cpp \
     widgets/elementselectiondialog.cpp \
+    widgets/loadcombinationdialog.cpp \
     widgets/easychange/easychangedialog.cpp \
     widgets/easychange/nodedialog.cpp \
     widgets/easychange/roddialog.cpp \
@@ -50,6 +53,7 @@ SOURCES += \
     elements/node.cpp \
     elements/rod.cpp \
     elements/trusselement.cpp \
+    elements/idallocator.cpp \
     elements/bearing.cpp \
     elements/singleforce.cpp \
     factories/nodeadder.cpp \
@@ -70,13 +74,15 @@ HEADERS += \
     pen.h \
     utilities.h \
     graphicsscene.h \
-    calculator.h \
+    spatialindex.h \
+    solver/calculationservice.h \
     widgets/mainwindow.h \
     widgets/graphicsview.h \
     widgets/lineedit.h \
     widgets/seteaiglobaldialog.h \
     widgets/settings.h \
     widgets/elementselectiondialog.h \
+    widgets/loadcombinationdialog.h \
     widgets/easychange/easychangedialog.h \
     widgets/easychange/nodedialog.h \
     widgets/easychange/roddialog.h \
@@ -85,13 +91,13 @@ HEADERS += \
     elements/node.h \
     elements/rod.h \
     elements/trusselement.h \
+    elements/idallocator.h \
     elements/bearing.h \
     elements/singleforce.h \
     factories/nodeadder.h \
     factories/rodadder.h \
     factories/bearingadder.h \
     factories/forceadder.h \
-    libs/Eigen/Eigen/Eigen \
     widgets/systemdefinitiondialog.h \
     elements/label.h \
     widgets/easychange/labeldialog.h \
@@ -106,5 +112,7 @@ FORMS += \
         widgets/seteaiglobaldialog.ui \
         widgets/systemdefinitiondialog.ui
 
+include(solver/solver.pri)
+
 RESOURCES += \
     resources/resources.qrc
@@ -2,6 +2,9 @@
 #define CALCULATOR_H
 
 #include "libs/Eigen/Eigen/Eigen"
+#include "solver/linearsolver.h"
+#include "solver/trussmodel.h"
+#include "solver/dofordering.h"
 
 #include <QList>
 
@@ -10,27 +13,141 @@ class Node;
 class Rod;
 class Bearing;
 class TrussElement;
+class FactorizationCache;
+
+enum class AnalysisType : int {
+    Automatic = 0, // truss if every node with beams is a gerber-joint, no bearing at such a node is a fixed clamping and no moment is applied, frame otherwise
+    Frame = 1, // every beam is an euler-bernoulli-beam with 6 dofs, the nodes have y, x and rotation-dofs (ropes only transfer normal-forces)
+    Truss = 2 // every rod only transfers normal-forces, 2 dofs per node (y, x), a fixed clamping acts like a locating bearing
+};
+
+enum class MassMatrix : int {
+    Consistent = 0, // the mass is distributed like the displacements of the rod (cubic transverse displacements of a beam), the frequencies are upper bounds
+    Lumped = 1 // half of the mass of every rod at each of its nodes without rotational inertia, the frequencies are usually somewhat too low
+};
 
 namespace Calculator
 {
-    QString calculate(GraphicsScene *scene);
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, 6, 6> ElementMatrix; // 6 x 6 for beams, 4 x 4 for bars and ropes, without heap-allocation
 
-    QString parseAndNumberElements(GraphicsScene *scene, int &dofCount, int &rodCount, QList<Rod *> &rods, QList<Node *> &nodes);
+    struct SolverSettings
+    {
+        int sparseAssemblyThreshold = 200; // systems with more dofs than this value get assembled into a sparse GSM
+        SolverBackend solverBackend = SolverBackend::Automatic;
+        DofOrdering dofOrdering = DofOrdering::ApproximateMinimumDegree; // order in which the nodes get their dofs
+        int maxLowRankUpdates = 32; // K_aa gets factorized again after this many low-rank updates of a cached factorization, 0: always factorize
+        AnalysisType analysisType = AnalysisType::Automatic;
+        int threadCount = 0; // threads that compute the ESMs and assemble the sparse GSM, 0: one per core, the results do not depend on it
+        int loadSteps = 0; // > 0: geometrically nonlinear (second-order) analysis, the loads are applied in this many increments (see solver/nonlinear.h), 0: linear
+        int maxNewtonIterations = 30; // per load-step, a step that does not converge is repeated with half the load-increment
+        double newtonTolerance = 1e-8; // relative norm of the out-of-balance forces below which a load-step has converged
+        int bucklingModes = 0; // > 0: the smallest load-factors and mode-shapes of the linear buckling analysis (see solver/buckling.h), 0: no buckling analysis
+        int bucklingColumn = 0; // result whose normal-forces buckle: the index of a load-case or the number of load-cases plus the index of a load-combination
+        int naturalModes = 0; // > 0: the lowest natural frequencies and mode-shapes of the modal analysis (see solver/modal.h), 0: no modal analysis
+        MassMatrix massMatrix = MassMatrix::Consistent;
+    };
 
-    QString determineESM(const QList<Rod *> &rods, QVector<Eigen::Matrix6d> &k_es);
+    struct LoadStepReport // convergence of one load-step of the second-order analysis
+    {
+        int column = 0; // load-case (then load-combination) the step belongs to
+        double loadFactor = 0; // share of the loads that is applied at the end of the step
+        int iterations = 0; // newton-iterations (factorizations of the tangent-stiffness-matrix)
+        int lineSearches = 0; // residual-evaluations of the line-search besides the full newton-steps
+        double residual = 0; // relative norm of the out-of-balance forces at the end of the step
+        bool converged = false; // a step that did not converge is repeated with half the load-increment
+        bool warmStart = false; // the step started from the converged displacements of the last solve() instead of from the unloaded system
+    };
 
-    QString assembleCoincidenceTable(const QList<Rod *> &rods, QVector<QVector<int>> &coincidenceTable);
+    struct Envelope // min/max of the results over all load-combinations, see solver/loadcombination.h
+    {
+        Eigen::VectorXd minU; // one entry per dof
+        Eigen::VectorXd maxU;
+        Eigen::VectorXd minF;
+        Eigen::VectorXd maxF;
+        Eigen::VectorXd minInnerForces; // one entry per rod
+        Eigen::VectorXd maxInnerForces;
+    };
 
-    QString assembleGSM(int dofCount, int rodCount, const QVector<QVector<int>> &coincidenceTable, const QVector<Eigen::Matrix6d> &k_es, Eigen::MatrixXd &K);
+    struct Solution // holds no ptrs to graphics-items, the index of a rod is the one in the model
+    {
+        int dofCount = 0;
+        QVector<int> nodeFirstDof; // the dofs of node i are nodeFirstDof[i] .. nodeFirstDof[i] + nodeDofCount[i] - 1 (y, x, then the rotation-dofs), see numberDofs()
+        QVector<int> nodeDofCount;
+        QVector<int> rodNode1; // node-indices of every rod in the solved model, the calc-ids of the nodes may already be renumbered when the solution gets applied
+        QVector<int> rodNode2;
+        QVector<RodType> rodTypes; // the kind every rod was computed as, see determineRodTypes()
+        QVector<QVector<int>> coincidenceTable; // global dofs of every rod, in the order of the dof-map of its rod-type (see solver/elementtraits.h)
+        QVector<Eigen::Matrix6d> T_es; // element-transformation-matrices
+        Eigen::MatrixXd F; // one column per load-case
+        Eigen::MatrixXd U; // one column per load-case
+        Eigen::MatrixXd innerForces; // normal-force [N], one row per rod and one column per load-case
+        Envelope envelope; // min/max over all load-combinations of the model (empty if there are none)
+        Eigen::MatrixXd combinationU; // one column per load-combination, only if the model has ropes or is solved second-order (then the combinations are not linear), see solve()
+        Eigen::MatrixXd combinationF;
+        Eigen::MatrixXd combinationInnerForces;
+        QVector<QVector<int>> slackRopes; // the slack ropes (rod-indices) of every load-case and then of every solved load-combination, see solver/tensiononly.h
+        int ropeIterations = 0; // active-set iterations of the ropes (the most of all load-cases), 0 if the model has no ropes
+        QVector<LoadStepReport> loadSteps; // every load-step of every column of a second-order analysis, empty for a linear analysis
+        Eigen::VectorXd bucklingFactors; // smallest load-factors (ascending) at which the loads of bucklingColumn make the system unstable, empty without buckling analysis
+        Eigen::MatrixXd bucklingModes; // one mode-shape per load-factor, one entry per dof like U, the largest displacement is 1
+        int bucklingColumn = 0; // settings.bucklingColumn limited to the existing results
+        int bucklingIterations = 0; // solves with K_aa of the lanczos-iteration
+        Eigen::VectorXd naturalFrequencies; // lowest natural frequencies [Hz] (ascending), empty without modal analysis
+        Eigen::MatrixXd naturalModes; // one mode-shape per frequency, like bucklingModes
+        int modalIterations = 0; // solves with K_aa of the lanczos-iteration, 0 if the modes of the last solve() with the same cache were reused
+        MassMatrix usedMassMatrix = MassMatrix::Consistent; // settings.massMatrix
+        SolverBackend usedBackend = SolverBackend::Automatic;
+        AnalysisType usedAnalysisType = AnalysisType::Frame; // never Automatic
+        DofOrdering usedOrdering = DofOrdering::Natural;
+        OrderingMetrics naturalMetrics; // metrics of the dofs numbered in the order of the nodes in the model
+        OrderingMetrics metrics; // metrics of the numbering that is actually used
+        int usedThreadCount = 1; // settings.threadCount resolved to the number of threads
+        double esmMilliseconds = 0; // time of the ESMs and of the assembly of K when K was last factorized, to measure how they scale with the threads
+        double assemblyMilliseconds = 0;
+        bool reusedFactorization = false; // true if only the loads changed since the last solve() with the same cache, K was neither assembled nor factorized then
+        int correctionRank = 0; // size of the low-rank correction of the cached factorization that was used, 0 if K_aa was solved as it was factorized
+    };
 
-    QString applyConstraints(const QList<Rod *> &rods, Eigen::VectorXd &F, Eigen::VectorXb &F_k, Eigen::VectorXd &U, Eigen::VectorXb &U_k);
-    
-    QString solveSystemOfEquations(int dofCount, const Eigen::VectorXb &F_k, const Eigen::VectorXb &U_k, const Eigen::MatrixXd &K, Eigen::VectorXd &F,
-                                   Eigen::VectorXd &U);
+    // the following fcts work on the scene and have to be called in the gui-thread (implemented in calculator.cpp)
+    QString calculate(GraphicsScene *scene); // extractModel(), solve() and applySolution() in one go
 
-    QString applyResults(GraphicsScene *scene, const QList<Rod *> &rods, const Eigen::VectorXd &F, const Eigen::VectorXd &U);
+    QString extractModel(GraphicsScene *scene, TrussModel &model, QList<Rod *> &rods); // rods holds the rods in the order of their index in the model
+    SolverSettings getSolverSettings(const GraphicsScene *scene);
+    QString applySolution(GraphicsScene *scene, const QList<Rod *> &rods, const Solution &solution);
+
+    QString applyResults(GraphicsScene *scene, const QList<Rod *> &rods, const Solution &solution);
 
     void cleanUp(GraphicsScene *scene);
+    void resetResults(GraphicsScene *scene);
+
+    // the following fcts do not access any graphics-items, therefore they are thread-safe and also used without a scene by trusscalc-cli (implemented in solver/calculatorcore.cpp)
+    QString solve(const TrussModel &model, const SolverSettings &settings, Solution &solution, FactorizationCache *cache = nullptr); // cache may be nullptr
+
+    QString factorizeSystem(const TrussModel &model, const SolverSettings &settings, FactorizationCache &factorization); // fills the load-independent part of factorization
+    QString updateFactorization(const TrussModel &model, const SolverSettings &settings, FactorizationCache &factorization); // corrects factorization for the changed ESMs of model, see FactorizationCache
+
+    AnalysisType determineAnalysisType(const TrussModel &model, const SolverSettings &settings); // resolves AnalysisType::Automatic
+    QString toString(AnalysisType analysisType);
+    QString toString(MassMatrix massMatrix);
+    QVector<RodType> determineRodTypes(const TrussModel &model, AnalysisType analysisType); // in a truss-analysis the beams are computed as bars
+
+    QString numberDofs(const TrussModel &model, const QVector<int> &nodeOrder, const QVector<RodType> &rodTypes, int &dofCount, QVector<int> &nodeFirstDof,
+                       QVector<int> &nodeDofCount, QVector<QVector<int>> &coincidenceTable); // the nodes get their dofs in the order given by nodeOrder
+
+    QString determineESM(const TrussModel &model, const QVector<RodType> &rodTypes, int threadCount, QVector<ElementMatrix> &k_es,
+                         QVector<Eigen::Matrix6d> &T_es); // T_es are always 6 x 6
+
+    QString assembleGSM(int dofCount, int rodCount, const QVector<QVector<int>> &coincidenceTable, const QVector<ElementMatrix> &k_es, Eigen::MatrixXd &K);
+
+    QString assembleSparseGSM(int dofCount, int rodCount, const QVector<QVector<int>> &coincidenceTable, const QVector<ElementMatrix> &k_es, int threadCount,
+                              Eigen::SparseMatrix<double> &K); // only the element-entries are stored, used for systems with more dofs than the sparse-assembly-threshold
+
+    QString applyConstraints(const TrussModel &model, const QVector<int> &nodeFirstDof, const QVector<int> &nodeDofCount, Eigen::MatrixXd &F, Eigen::VectorXb &F_k,
+                             Eigen::MatrixXd &U, Eigen::VectorXb &U_k); // F and U get one column per load-case, the known-flags are the same for all load-cases
+
+
+    QString determineInnerForces(const TrussModel &model, const QVector<RodType> &rodTypes, const QVector<QVector<int>> &coincidenceTable, const Eigen::MatrixXd &U,
+                                 Eigen::MatrixXd &innerForces); // one column per load-case
 }
 
 #endif // CALCULATOR_H
@@ -0,0 +1,144 @@
+#include "historyfiles.h"
+
+#include "trussfile.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace
+{
+    QStringList splitCsvLine(const QString &line) // fields quoted like RFC 4180 (see ResultWriter::toCsv()) may contain commas and quotes
+    {
+        QStringList fields;
+        QString field;
+        bool quoted = false;
+        for (int i = 0; i < line.size(); i++) {
+            QChar c = line.at(i);
+            if (quoted) {
+                if (c == '"' && i + 1 < line.size() && line.at(i + 1) == '"') {
+                    field += '"';
+                    i++;
+                } else if (c == '"') {
+                    quoted = false;
+                } else {
+                    field += c;
+                }
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                fields.append(field.trimmed());
+                field.clear();
+            } else {
+                field += c;
+            }
+        }
+        fields.append(field.trimmed());
+        return fields;
+    }
+} // end anonymous namespace
+
+QString LoadHistoryReader::open(const QString &filePath, const TrussModel &model)
+{
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return "could not open the load-history " + filePath + ": " + file.errorString();
+    }
+    stream.setDevice(&file);
+    stream.setCodec("UTF-8"); // the load-case names can have umlauts
+    loadCaseCount = model.getLoadCaseCount();
+    line = 1;
+    QStringList header = splitCsvLine(stream.readLine());
+    columnLoadCases.clear();
+    for (int column = 1; column < header.size(); column++) { // the first column is the time
+        int loadCase = model.loadCaseNames.indexOf(header.at(column));
+        if (loadCase == -1) {
+            return "the load-history has a column " + header.at(column) + ", but the file has no load-case of that name";
+        }
+        if (columnLoadCases.contains(loadCase)) {
+            return "the load-history has more than one column for the load-case " + header.at(column);
+        }
+        columnLoadCases.append(loadCase);
+    }
+    return "";
+}
+
+QString LoadHistoryReader::read(double &time, Eigen::VectorXd &factors, bool &atEnd)
+{
+    QString text;
+    do { // empty lines (e.g. at the end of the file) are skipped
+        if (stream.atEnd()) {
+            atEnd = true;
+            return "";
+        }
+        text = stream.readLine();
+        line++;
+    } while (text.trimmed().isEmpty());
+    QStringList fields = splitCsvLine(text);
+    if (fields.size() != columnLoadCases.size() + 1) {
+        return "line " + QString::number(line) + " of the load-history has " + QString::number(fields.size()) + " columns instead of "
+                + QString::number(columnLoadCases.size() + 1);
+    }
+    bool ok = false;
+    time = fields.at(0).toDouble(&ok);
+    factors = Eigen::VectorXd::Zero(loadCaseCount);
+    for (int column = 0; column < columnLoadCases.size() && ok; column++) {
+        factors(columnLoadCases.at(column)) = fields.at(column + 1).toDouble(&ok);
+    }
+    if (!ok) {
+        return "line " + QString::number(line) + " of the load-history contains something else than numbers";
+    }
+    atEnd = false;
+    return "";
+}
+
+QString HistoryWriter::open(const QString &filePath, const TrussFile &file, const Calculator::Solution &solution)
+{
+    output.setFileName(filePath);
+    if (!output.open(QIODevice::WriteOnly)) {
+        return "could not write " + filePath + ": " + output.errorString();
+    }
+    nodeFirstDof = solution.nodeFirstDof;
+    nodeDofCount = solution.nodeDofCount;
+    QJsonArray columns{"time"};
+    for (const QString &id : file.nodeIds) {
+        columns.append("ux:" + id);
+        columns.append("uy:" + id);
+    }
+    for (const QString &id : file.rodIds) {
+        columns.append("N:" + id);
+    }
+    QJsonObject header;
+    header.insert("columns", columns);
+    header.insert("type", "float32le");
+    output.write(QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n');
+    stream.setDevice(&output);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision); // the doubles are written as floats
+    return "";
+}
+
+QString HistoryWriter::write(double time, const Eigen::VectorXd &U, const Eigen::VectorXd &innerForces)
+{
+    stream << time;
+    for (int node = 0; node < nodeFirstDof.size(); node++) {
+        int first = nodeFirstDof.at(node);
+        bool hasDofs = nodeDofCount.at(node) > 0; // a node without rods does not move
+        stream << (hasDofs ? U(first + 1) : 0.0) << (hasDofs ? - U(first) : 0.0); // - because the y-axis is upwards positive in the output
+    }
+    for (int e = 0; e < innerForces.size(); e++) {
+        stream << innerForces(e);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        return "could not write " + output.fileName() + ": " + output.errorString();
+    }
+    return "";
+}
+
+QString HistoryWriter::commit()
+{
+    if (!output.commit()) {
+        return "could not write " + output.fileName() + ": " + output.errorString();
+    }
+    return "";
+}
@@ -0,0 +1,50 @@
+#ifndef HISTORYFILES_H
+#define HISTORYFILES_H
+
+#include "calculator.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+
+struct TrussFile;
+
+// load-history of the time-history analysis (see solver/timehistory.h): a csv-file with a header and one row per time-step, the first column is the time [s],
+// every other column is named like a load-case and holds the factor of its loads (load-cases without a column get 0), e.g.
+//      time,Eigengewicht,Fußgänger
+//      0,1,0
+//      0.01,1,0.35
+// it is read row by row, therefore a history with any number of steps only needs the memory of one row
+class LoadHistoryReader
+{
+public:
+    QString open(const QString &filePath, const TrussModel &model); // reads the header, returns an error-message if it does not match the load-cases of model
+    QString read(double &time, Eigen::VectorXd &factors, bool &atEnd); // next row, see TimeHistory::LoadReader
+
+private:
+    QFile file;
+    QTextStream stream;
+    QVector<int> columnLoadCases; // load-case of every column after the time
+    int loadCaseCount = 0;
+    int line = 0;
+};
+
+// results of every time-step in a compact binary file: one header-line (json) with the names of the columns, then one record per time-step with a float
+// (32 bit, little-endian) per column: the time [s], ux and uy of every node [m] (signs like in ResultWriter) and the normal-force of every rod [N]
+// the records are written to a temporary file while the analysis runs, commit() replaces the file with it, without commit() the file is left as it was
+class HistoryWriter
+{
+public:
+    QString open(const QString &filePath, const TrussFile &file, const Calculator::Solution &solution); // writes the header
+    QString write(double time, const Eigen::VectorXd &U, const Eigen::VectorXd &innerForces); // see TimeHistory::StepWriter
+    QString commit();
+
+private:
+    QSaveFile output;
+    QDataStream stream;
+    QVector<int> nodeFirstDof;
+    QVector<int> nodeDofCount;
+};
+
+#endif // HISTORYFILES_H
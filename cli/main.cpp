@@ -0,0 +1,330 @@
+#include "calculator.h"
+#include "cli/historyfiles.h"
+#include "cli/trussfile.h"
+#include "cli/resultwriter.h"
+#include "solver/factorizationcache.h"
+#include "solver/timehistory.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+namespace
+{
+    struct FileResult
+    {
+        QString filePath;
+        QString status; // "" if the file was solved and its results were written
+        int dofCount = 0;
+        SolverBackend usedBackend = SolverBackend::Automatic;
+        AnalysisType usedAnalysisType = AnalysisType::Frame;
+        OrderingMetrics naturalMetrics;
+        OrderingMetrics metrics;
+        int threadCount = 1;
+        double esmMilliseconds = 0;
+        double assemblyMilliseconds = 0;
+        int historySteps = 0; // time-steps of the time-history analysis, 0 without one
+        double timeStep = 0; // [s]
+    };
+
+    struct SolveFile // functor for QtConcurrent, every file is solved independently, therefore it can be called from multiple threads at once
+    {
+        typedef FileResult result_type;
+
+        FileResult operator()(const QString &filePath) const
+        {
+            FileResult result;
+            result.filePath = filePath;
+            TrussFile file;
+            result.status = file.load(filePath);
+            if (result.status != "") {
+                return result;
+            }
+            Calculator::SolverSettings fileSettings = settings;
+            if (useProjectAnalysisType) {
+                fileSettings.analysisType = file.analysisType;
+            }
+            if (useProjectLoadSteps) {
+                fileSettings.loadSteps = file.loadSteps;
+            }
+            if (useProjectBucklingModes) {
+                fileSettings.bucklingModes = file.bucklingModes;
+            }
+            if (useProjectNaturalModes) {
+                fileSettings.naturalModes = file.naturalModes;
+            }
+            if (useProjectMassMatrix) {
+                fileSettings.massMatrix = file.massMatrix;
+            }
+            if (!bucklingResult.isEmpty()) { // a load-case or a load-combination, like the result shown in the gui
+                int combination = -1;
+                for (int c = 0; c < file.model.loadCombinations.size() && combination == -1; c++) {
+                    if (file.model.loadCombinations.at(c).name == bucklingResult) {
+                        combination = c;
+                    }
+                }
+                int loadCase = file.model.loadCaseNames.indexOf(bucklingResult);
+                if (loadCase == -1 && combination == -1) {
+                    result.status = "the file has no load-case or load-combination named " + bucklingResult;
+                    return result;
+                }
+                fileSettings.bucklingColumn = loadCase != -1 ? loadCase : file.model.getLoadCaseCount() + combination;
+            }
+            Calculator::Solution solution;
+            FactorizationCache factorization; // the time-history analysis reuses the numbering, partition and K_aa of the linear solve
+            result.status = Calculator::solve(file.model, fileSettings, solution, loadHistory.isEmpty() ? nullptr : &factorization);
+            if (result.status != "") {
+                return result;
+            }
+            QFileInfo info(filePath);
+            QDir dir(outputDir.isEmpty() ? info.absolutePath() : outputDir);
+            TimeHistory::Result history;
+            if (!loadHistory.isEmpty()) { // the steps are streamed from the load-history to <name>.history.bin, only the peaks stay in memory
+                LoadHistoryReader reader;
+                HistoryWriter writer;
+                result.status = reader.open(loadHistory, file.model);
+                if (result.status == "") {
+                    result.status = writer.open(dir.filePath(info.completeBaseName() + ".history.bin"), file, solution);
+                }
+                if (result.status == "") {
+                    result.status = TimeHistory::solve(file.model, fileSettings, factorization, historySettings,
+                                                       [&reader](double &time, Eigen::VectorXd &factors, bool &atEnd) {
+                                                           return reader.read(time, factors, atEnd);
+                                                       },
+                                                       [&writer](double time, const Eigen::VectorXd &U, const Eigen::VectorXd &innerForces) {
+                                                           return writer.write(time, U, innerForces);
+                                                       }, history);
+                }
+                if (result.status == "") {
+                    result.status = writer.commit();
+                }
+                if (result.status != "") {
+                    return result;
+                }
+                result.historySteps = history.steps;
+                result.timeStep = history.timeStep;
+            }
+            result.dofCount = solution.dofCount;
+            result.usedBackend = solution.usedBackend;
+            result.usedAnalysisType = solution.usedAnalysisType;
+            result.naturalMetrics = solution.naturalMetrics;
+            result.metrics = solution.metrics;
+            result.threadCount = solution.usedThreadCount;
+            result.esmMilliseconds = solution.esmMilliseconds;
+            result.assemblyMilliseconds = solution.assemblyMilliseconds;
+            QString outputPath = dir.filePath(info.completeBaseName() + ".results." + format);
+            QSaveFile output(outputPath);
+            if (!output.open(QIODevice::WriteOnly)) {
+                result.status = "could not write " + outputPath + ": " + output.errorString();
+                return result;
+            }
+            output.write(format == "csv" ? ResultWriter::toCsv(file, solution) : ResultWriter::toJson(file, solution, loadHistory.isEmpty() ? nullptr : &history));
+            if (!output.commit()) {
+                result.status = "could not write " + outputPath + ": " + output.errorString();
+            }
+            return result;
+        }
+
+        Calculator::SolverSettings settings;
+        bool useProjectAnalysisType = true; // false: settings.analysisType overrides the one saved in the files
+        bool useProjectLoadSteps = true; // false: settings.loadSteps overrides the one saved in the files
+        bool useProjectBucklingModes = true; // false: settings.bucklingModes overrides the one saved in the files
+        QString bucklingResult; // name of the load-case or load-combination whose normal-forces buckle, empty: the first load-case
+        bool useProjectNaturalModes = true; // false: settings.naturalModes overrides the one saved in the files
+        bool useProjectMassMatrix = true; // false: settings.massMatrix overrides the one saved in the files
+        QString loadHistory; // csv-file with the load-factors over time (see LoadHistoryReader), empty: no time-history analysis
+        TimeHistory::Settings historySettings;
+        QString format; // "json" or "csv"
+        QString outputDir; // empty: next to the input-file
+    };
+
+    bool parseSolverBackend(const QString &name, SolverBackend &backend)
+    {
+        const QStringList names{"automatic", "sparse-ldlt", "sparse-llt", "dense-ldlt", "dense-cod"}; // same order as SolverBackend
+        int index = names.indexOf(name.toLower());
+        if (index == -1) {
+            return false;
+        }
+        backend = static_cast<SolverBackend>(index);
+        return true;
+    }
+
+    bool parseDofOrdering(const QString &name, DofOrdering &ordering)
+    {
+        const QStringList names{"natural", "rcm", "amd", "nd"}; // same order as DofOrdering
+        int index = names.indexOf(name.toLower());
+        if (index == -1) {
+            return false;
+        }
+        ordering = static_cast<DofOrdering>(index);
+        return true;
+    }
+
+    bool parseAnalysisType(const QString &name, bool &useProjectAnalysisType, AnalysisType &analysisType)
+    {
+        const QStringList names{"project", "automatic", "frame", "truss"}; // same order as AnalysisType, after "project"
+        int index = names.indexOf(name.toLower());
+        if (index == -1) {
+            return false;
+        }
+        useProjectAnalysisType = index == 0;
+        analysisType = index == 0 ? AnalysisType::Automatic : static_cast<AnalysisType>(index - 1);
+        return true;
+    }
+
+    bool parseMassMatrix(const QString &name, bool &useProjectMassMatrix, MassMatrix &massMatrix)
+    {
+        const QStringList names{"project", "consistent", "lumped"}; // same order as MassMatrix, after "project"
+        int index = names.indexOf(name.toLower());
+        if (index == -1) {
+            return false;
+        }
+        useProjectMassMatrix = index == 0;
+        massMatrix = index == 0 ? MassMatrix::Consistent : static_cast<MassMatrix>(index - 1);
+        return true;
+    }
+
+    bool parseCount(const QString &value, bool &useProject, int &count) // a count >= 0 or "project"
+    {
+        useProject = value.toLower() == "project";
+        if (useProject) {
+            return true;
+        }
+        bool ok = false;
+        count = value.toInt(&ok);
+        return ok && count >= 0;
+    }
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("trusscalc-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Solves truss-files saved by TrussCalculator and writes the displacements, rod-forces and reactions of every file "
+                                     "to <name>.results.json (or .csv).");
+    parser.addHelpOption();
+    QCommandLineOption formatOption({"f", "format"}, "Output format: json or csv.", "format", "json");
+    QCommandLineOption outputDirOption({"o", "output-dir"}, "Directory for the result-files (default: next to the input-files).", "directory");
+    QCommandLineOption jobsOption({"j", "jobs"}, "Number of files solved in parallel (default: number of cores).", "count", QString::number(QThread::idealThreadCount()));
+    QCommandLineOption solverOption("solver", "Linear solver: automatic, sparse-ldlt, sparse-llt, dense-ldlt or dense-cod.", "solver", "automatic");
+    QCommandLineOption thresholdOption("sparse-threshold", "Systems with more dofs than this get assembled into a sparse stiffness-matrix.", "dofs", "200");
+    QCommandLineOption orderingOption("ordering", "Dof numbering: natural, rcm (reverse Cuthill-McKee), amd (approximate minimum degree) or nd (nested dissection).",
+                                      "ordering", "amd");
+    QCommandLineOption analysisOption("analysis", "Analysis type: project (as saved in the file), automatic (truss if every node is a gerber-joint), "
+                                      "frame (3 dofs per node) or truss (2 dofs per node).", "type", "project");
+    QCommandLineOption threadsOption("threads", "Threads that compute the element matrices and assemble the stiffness-matrix of one file (default: 0, one per core); "
+                                     "the results do not depend on it.", "count", "0");
+    QCommandLineOption loadStepsOption("load-steps", "Second-order (geometrically nonlinear) analysis with this many load-steps, 0: linear analysis, "
+                                       "project: as saved in the file.", "count", "project");
+    QCommandLineOption bucklingModesOption("buckling-modes", "Linear buckling analysis with this many load-factors and mode-shapes (json only), 0: none, "
+                                           "project: as saved in the file.", "count", "project");
+    QCommandLineOption bucklingResultOption("buckling-result", "Load-case or load-combination whose normal-forces the buckling analysis uses "
+                                            "(default: the first load-case).", "name");
+    QCommandLineOption naturalModesOption("natural-modes", "Modal analysis with this many natural frequencies and mode-shapes (json only), 0: none, "
+                                          "project: as saved in the file.", "count", "project");
+    QCommandLineOption massMatrixOption("mass-matrix", "Mass-matrices of the rods in the modal analysis: project (as saved in the file), consistent or lumped.",
+                                        "type", "project");
+    QCommandLineOption timeHistoryOption("time-history", "Time-history analysis (HHT-alpha/Newmark) over this csv-file: a column with the time [s] and one column "
+                                         "of load-factors per load-case (named like the load-case, missing ones are 0), equidistant times. The results of every step "
+                                         "are written to <name>.history.bin, their peaks to the json-output (json only).", "file");
+    QCommandLineOption hhtAlphaOption("hht-alpha", "Alpha of the HHT-method in [-1/3, 0], 0: Newmark average acceleration.", "alpha", "0");
+    QCommandLineOption dampingOption("damping", "Rayleigh damping ratio of the time-history analysis at the two lowest natural frequencies (e.g. 0.02).",
+                                     "ratio", "0");
+    parser.addOptions({formatOption, outputDirOption, jobsOption, solverOption, thresholdOption, orderingOption, analysisOption, threadsOption, loadStepsOption,
+                       bucklingModesOption, bucklingResultOption, naturalModesOption, massMatrixOption, timeHistoryOption, hhtAlphaOption, dampingOption});
+    parser.addPositionalArgument("files", "Truss-files (.json) to solve.", "files...");
+    parser.process(a);
+
+    QTextStream err(stderr);
+    QTextStream out(stdout);
+    SolveFile solveFile;
+    solveFile.format = parser.value(formatOption).toLower();
+    solveFile.outputDir = parser.value(outputDirOption);
+    bool ok = solveFile.format == "json" || solveFile.format == "csv";
+    if (ok) {
+        ok = parseSolverBackend(parser.value(solverOption), solveFile.settings.solverBackend);
+    }
+    if (ok) {
+        ok = parseDofOrdering(parser.value(orderingOption), solveFile.settings.dofOrdering);
+    }
+    if (ok) {
+        ok = parseAnalysisType(parser.value(analysisOption), solveFile.useProjectAnalysisType, solveFile.settings.analysisType);
+    }
+    if (ok) {
+        ok = parseCount(parser.value(loadStepsOption), solveFile.useProjectLoadSteps, solveFile.settings.loadSteps);
+    }
+    if (ok) {
+        ok = parseCount(parser.value(bucklingModesOption), solveFile.useProjectBucklingModes, solveFile.settings.bucklingModes);
+    }
+    solveFile.bucklingResult = parser.value(bucklingResultOption);
+    if (ok) {
+        ok = parseCount(parser.value(naturalModesOption), solveFile.useProjectNaturalModes, solveFile.settings.naturalModes);
+    }
+    if (ok) {
+        ok = parseMassMatrix(parser.value(massMatrixOption), solveFile.useProjectMassMatrix, solveFile.settings.massMatrix);
+    }
+    solveFile.loadHistory = parser.value(timeHistoryOption);
+    if (ok) {
+        solveFile.historySettings.alpha = parser.value(hhtAlphaOption).toDouble(&ok);
+        ok = ok && solveFile.historySettings.alpha >= -1.0 / 3 && solveFile.historySettings.alpha <= 0;
+    }
+    if (ok) {
+        solveFile.historySettings.dampingRatio = parser.value(dampingOption).toDouble(&ok);
+        ok = ok && solveFile.historySettings.dampingRatio >= 0;
+    }
+    if (ok) {
+        solveFile.settings.sparseAssemblyThreshold = parser.value(thresholdOption).toInt(&ok);
+    }
+    if (ok) {
+        solveFile.settings.threadCount = parser.value(threadsOption).toInt(&ok);
+        ok = ok && solveFile.settings.threadCount >= 0;
+    }
+    int jobs = 0;
+    if (ok) {
+        jobs = parser.value(jobsOption).toInt(&ok);
+        ok = ok && jobs > 0;
+    }
+    QStringList files = parser.positionalArguments();
+    if (!ok || files.isEmpty()) {
+        err << parser.helpText();
+        return 2;
+    }
+    if (!solveFile.loadHistory.isEmpty() && solveFile.format != "json") { // the peaks of the time-history are only kept in memory, the csv-output has no place for them
+        err << "--time-history needs --format json, the peaks of the time-history are written to the json-output\n";
+        return 2;
+    }
+    if (!solveFile.outputDir.isEmpty() && !QDir().mkpath(solveFile.outputDir)) {
+        err << "could not create the output directory " << solveFile.outputDir << "\n";
+        return 2;
+    }
+
+    QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+    QList<FileResult> results = QtConcurrent::blockingMapped<QList<FileResult>>(files, solveFile);
+
+    int failed = 0;
+    for (const FileResult &result : results) { // same order as the input-files
+        if (result.status != "") {
+            err << result.filePath << ": " << result.status << "\n";
+            failed++;
+        } else {
+            out << result.filePath << ": " << result.dofCount << " dofs (" << (result.usedAnalysisType == AnalysisType::Truss ? "truss" : "frame") << "), "
+                << LinearSolver::toString(result.usedBackend) << "\n";
+            out << "    bandwidth " << result.naturalMetrics.bandwidth << " -> " << result.metrics.bandwidth << ", profile " << result.naturalMetrics.profile << " -> "
+                << result.metrics.profile << ", factor non-zeros " << result.naturalMetrics.factorNonZeros << " -> " << result.metrics.factorNonZeros << "\n";
+            out << "    " << result.threadCount << (result.threadCount == 1 ? " thread" : " threads") << ": element matrices " << result.esmMilliseconds << " ms, assembly "
+                << result.assemblyMilliseconds << " ms\n";
+            if (result.historySteps > 0) {
+                out << "    time-history: " << result.historySteps << " steps of " << result.timeStep << " s\n";
+            }
+        }
+    }
+    return failed > 0 ? 1 : 0;
+}
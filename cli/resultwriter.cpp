@@ -0,0 +1,271 @@
+#include "resultwriter.h"
+
+#include "trussfile.h"
+#include "solver/loadcombination.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+namespace
+{
+    struct NodeResult
+    {
+        double ux = 0;
+        double uy = 0;
+        double fx = 0;
+        double fy = 0;
+        double mz = 0;
+    };
+
+    QVector<NodeResult> determineNodeResults(const TrussModel &model, const Calculator::Solution &solution, int loadCase)
+    {
+        QVector<NodeResult> results(model.getNodeCount());
+        for (int node = 0; node < model.getNodeCount(); node++) {
+            int first = solution.nodeFirstDof.at(node);
+            int end = first + solution.nodeDofCount.at(node);
+            if (first == end) { // node without rods
+                continue;
+            }
+            NodeResult &result = results[node];
+            result.uy = - solution.U(first, loadCase); // - because the y-axis is upwards positive in the output (but downwards in calculation)
+            result.ux = solution.U(first + 1, loadCase);
+            result.fy = - solution.F(first, loadCase);
+            result.fx = solution.F(first + 1, loadCase);
+            for (int m = first + 2; m < end; m++) { // at a gerber-joint every rod has its own rotation-dof, the moments of all of them add up
+                result.mz += solution.F(m, loadCase);
+            }
+        }
+        return results;
+    }
+
+    QJsonArray determineModeShape(const TrussFile &file, const Calculator::Solution &solution, const Eigen::MatrixXd &modes, int mode) // displacements of the nodes
+    {
+        QJsonArray nodes;
+        for (int i = 0; i < file.model.getNodeCount(); i++) {
+            int first = solution.nodeFirstDof.at(i);
+            QJsonObject node;
+            node.insert("id", file.nodeIds.at(i));
+            if (solution.nodeDofCount.at(i) > 0) {
+                node.insert("ux", modes(first + 1, mode));
+                node.insert("uy", - modes(first, mode)); // see determineNodeResults()
+            }
+            nodes.append(node);
+        }
+        return nodes;
+    }
+
+    QJsonObject determineEnvelope(const TrussFile &file, const Calculator::Solution &solution) // min/max over all load-combinations
+    {
+        const TrussModel &model = file.model;
+        const Calculator::Envelope &envelope = solution.envelope;
+        Eigen::MatrixXd factors = Combination::determineFactors(model);
+        QJsonArray combinations;
+        for (const LoadCombination &combination : model.loadCombinations) {
+            combinations.append(Combination::toString(combination, model.loadCaseNames));
+        }
+        QJsonArray nodes;
+        for (int i = 0; i < model.getNodeCount(); i++) {
+            int first = solution.nodeFirstDof.at(i);
+            int end = first + solution.nodeDofCount.at(i);
+            QJsonObject node;
+            node.insert("id", file.nodeIds.at(i));
+            if (first == end) { // node without rods
+                nodes.append(node);
+                continue;
+            }
+            // the y-values change their sign (see determineNodeResults()), therefore their min and max get swapped
+            node.insert("minUx", envelope.minU(first + 1));
+            node.insert("maxUx", envelope.maxU(first + 1));
+            node.insert("minUy", - envelope.maxU(first));
+            node.insert("maxUy", - envelope.minU(first));
+            if (model.nodeHasBearing.at(i)) {
+                node.insert("minFx", envelope.minF(first + 1));
+                node.insert("maxFx", envelope.maxF(first + 1));
+                node.insert("minFy", - envelope.maxF(first));
+                node.insert("maxFy", - envelope.minF(first));
+                // mz is the sum of the rotation-dofs, the extremes of a sum are not the sums of the extremes, therefore take the extremes of the sums
+                // with ropes or in a second-order analysis every combination was solved on its own (the results are not linear in the loads, not even F of the load-cases),
+                // otherwise the sums of the load-cases are combined
+                bool solvedCombinations = factors.cols() > 0 && solution.combinationF.cols() == factors.cols(); // like Combination::determineEnvelope()
+                Eigen::RowVectorXd mz = solvedCombinations ? Eigen::RowVectorXd(solution.combinationF.middleRows(first + 2, end - first - 2).colwise().sum())
+                                                           : Eigen::RowVectorXd(solution.F.middleRows(first + 2, end - first - 2).colwise().sum() * factors);
+                node.insert("minMz", mz.minCoeff());
+                node.insert("maxMz", mz.maxCoeff());
+            }
+            nodes.append(node);
+        }
+        QJsonArray rods;
+        for (int e = 0; e < model.getRodCount(); e++) {
+            QJsonObject rod;
+            rod.insert("id", file.rodIds.at(e));
+            rod.insert("minNormalForce", envelope.minInnerForces(e));
+            rod.insert("maxNormalForce", envelope.maxInnerForces(e));
+            rods.append(rod);
+        }
+        QJsonObject result;
+        result.insert("combinations", combinations);
+        result.insert("nodes", nodes);
+        result.insert("rods", rods);
+        return result;
+    }
+
+    QJsonObject determineHistoryPeaks(const TrussFile &file, const Calculator::Solution &solution, const TimeHistory::Result &history) // min/max over all time-steps
+    {
+        QJsonArray nodes;
+        for (int i = 0; i < file.model.getNodeCount(); i++) {
+            int first = solution.nodeFirstDof.at(i);
+            QJsonObject node;
+            node.insert("id", file.nodeIds.at(i));
+            if (solution.nodeDofCount.at(i) > 0) { // the y-values change their sign like in determineEnvelope()
+                node.insert("minUx", history.minU(first + 1));
+                node.insert("maxUx", history.maxU(first + 1));
+                node.insert("minUy", - history.maxU(first));
+                node.insert("maxUy", - history.minU(first));
+            }
+            nodes.append(node);
+        }
+        QJsonArray rods;
+        for (int e = 0; e < file.model.getRodCount(); e++) {
+            QJsonObject rod;
+            rod.insert("id", file.rodIds.at(e));
+            rod.insert("minNormalForce", history.minInnerForces(e));
+            rod.insert("minNormalForceTime", history.minInnerForceTimes(e));
+            rod.insert("maxNormalForce", history.maxInnerForces(e));
+            rod.insert("maxNormalForceTime", history.maxInnerForceTimes(e));
+            rods.append(rod);
+        }
+        QJsonObject result;
+        result.insert("steps", history.steps);
+        result.insert("timeStep", history.timeStep);
+        result.insert("massDamping", history.massDamping);
+        result.insert("stiffnessDamping", history.stiffnessDamping);
+        result.insert("nodes", nodes);
+        result.insert("rods", rods);
+        return result;
+    }
+} // end anonymous namespace
+
+QByteArray ResultWriter::toJson(const TrussFile &file, const Calculator::Solution &solution, const TimeHistory::Result *history)
+{
+    const TrussModel &model = file.model;
+    QJsonArray loadCases;
+    for (int loadCase = 0; loadCase < model.getLoadCaseCount(); loadCase++) {
+        auto nodeResults = determineNodeResults(model, solution, loadCase);
+        QJsonArray nodes;
+        for (int i = 0; i < model.getNodeCount(); i++) {
+            QJsonObject node;
+            node.insert("id", file.nodeIds.at(i));
+            node.insert("ux", nodeResults.at(i).ux);
+            node.insert("uy", nodeResults.at(i).uy);
+            if (model.nodeHasBearing.at(i)) {
+                node.insert("fx", nodeResults.at(i).fx);
+                node.insert("fy", nodeResults.at(i).fy);
+                node.insert("mz", nodeResults.at(i).mz);
+            }
+            nodes.append(node);
+        }
+        QJsonArray rods;
+        for (int e = 0; e < model.getRodCount(); e++) {
+            QJsonObject rod;
+            rod.insert("id", file.rodIds.at(e));
+            rod.insert("node1", file.nodeIds.at(model.rodNode1.at(e)));
+            rod.insert("node2", file.nodeIds.at(model.rodNode2.at(e)));
+            rod.insert("normalForce", solution.innerForces(e, loadCase));
+            rods.append(rod);
+        }
+        QJsonObject result;
+        result.insert("name", model.loadCaseNames.at(loadCase));
+        result.insert("nodes", nodes);
+        result.insert("rods", rods);
+        loadCases.append(result);
+    }
+    QJsonObject root;
+    root.insert("dofCount", solution.dofCount);
+    root.insert("solver", LinearSolver::toString(solution.usedBackend));
+    root.insert("analysis", solution.usedAnalysisType == AnalysisType::Truss ? "truss" : "frame");
+    root.insert("loadCases", loadCases);
+    if (!model.loadCombinations.isEmpty()) {
+        root.insert("envelope", determineEnvelope(file, solution));
+    }
+    if (!solution.loadSteps.isEmpty()) { // convergence of the second-order analysis, the columns after the load-cases are the load-combinations
+        QJsonArray loadSteps;
+        for (const Calculator::LoadStepReport &step : solution.loadSteps) {
+            QJsonObject report;
+            report.insert("column", step.column);
+            report.insert("loadFactor", step.loadFactor);
+            report.insert("iterations", step.iterations);
+            report.insert("lineSearches", step.lineSearches);
+            report.insert("residual", step.residual);
+            report.insert("converged", step.converged);
+            report.insert("warmStart", step.warmStart);
+            loadSteps.append(report);
+        }
+        root.insert("loadSteps", loadSteps);
+    }
+    if (solution.bucklingFactors.size() > 0) {
+        int loadCaseCount = model.getLoadCaseCount();
+        QJsonArray modes;
+        for (int mode = 0; mode < solution.bucklingFactors.size(); mode++) {
+            QJsonObject result;
+            result.insert("loadFactor", solution.bucklingFactors(mode));
+            result.insert("nodes", determineModeShape(file, solution, solution.bucklingModes, mode));
+            modes.append(result);
+        }
+        QJsonObject buckling;
+        buckling.insert("result", solution.bucklingColumn < loadCaseCount ? model.loadCaseNames.at(solution.bucklingColumn)
+                                                                          : model.loadCombinations.at(solution.bucklingColumn - loadCaseCount).name);
+        buckling.insert("modes", modes);
+        root.insert("buckling", buckling);
+    }
+    if (solution.naturalFrequencies.size() > 0) {
+        QJsonArray modes;
+        for (int mode = 0; mode < solution.naturalFrequencies.size(); mode++) {
+            QJsonObject result;
+            result.insert("frequency", solution.naturalFrequencies(mode)); // [Hz]
+            result.insert("nodes", determineModeShape(file, solution, solution.naturalModes, mode));
+            modes.append(result);
+        }
+        QJsonObject modal;
+        modal.insert("massMatrix", solution.usedMassMatrix == MassMatrix::Lumped ? "lumped" : "consistent");
+        modal.insert("modes", modes);
+        root.insert("modal", modal);
+    }
+    if (history != nullptr) {
+        root.insert("timeHistory", determineHistoryPeaks(file, solution, *history));
+    }
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+QByteArray ResultWriter::toCsv(const TrussFile &file, const Calculator::Solution &solution)
+{
+    const TrussModel &model = file.model;
+    QByteArray csv;
+    QTextStream stream(&csv);
+    stream.setRealNumberPrecision(17); // enough digits to restore the doubles exactly
+    stream << "loadCase,element,id,node1,node2,ux,uy,fx,fy,mz,normalForce\n";
+    for (int loadCase = 0; loadCase < model.getLoadCaseCount(); loadCase++) {
+        auto nodeResults = determineNodeResults(model, solution, loadCase);
+        QString name = model.loadCaseNames.at(loadCase);
+        if (name.contains(',') || name.contains('"')) { // quote the name like RFC 4180
+            name = '"' + name.replace('"', "\"\"") + '"';
+        }
+        for (int i = 0; i < model.getNodeCount(); i++) {
+            const NodeResult &result = nodeResults.at(i);
+            stream << name << ",node," << file.nodeIds.at(i) << ",,," << result.ux << "," << result.uy << ",";
+            if (model.nodeHasBearing.at(i)) {
+                stream << result.fx << "," << result.fy << "," << result.mz;
+            } else {
+                stream << ",,";
+            }
+            stream << ",\n";
+        }
+        for (int e = 0; e < model.getRodCount(); e++) {
+            stream << name << ",rod," << file.rodIds.at(e) << "," << file.nodeIds.at(model.rodNode1.at(e)) << "," << file.nodeIds.at(model.rodNode2.at(e)) << ",,,,,,"
+                   << solution.innerForces(e, loadCase) << "\n";
+        }
+    }
+    stream.flush();
+    return csv;
+}
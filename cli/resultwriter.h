@@ -0,0 +1,20 @@
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+
+#include "calculator.h"
+#include "solver/timehistory.h"
+
+#include <QByteArray>
+
+struct TrussFile;
+
+// formats the solution of a truss-file, the signs are the same as shown in the gui (x: right, y: up, moments: counterclockwise positive)
+// nodes: displacements ux, uy [m] and for nodes with a bearing the reactions fx, fy [N] and mz [Nm]; rods: normal-force [N] (positive: pulling)
+// every load-case of the file is written separately, the json-output also holds the results of the optional analyses (buckling, modal, time-history)
+namespace ResultWriter
+{
+    QByteArray toJson(const TrussFile &file, const Calculator::Solution &solution, const TimeHistory::Result *history = nullptr); // history: peaks of a time-history, may be nullptr
+    QByteArray toCsv(const TrussFile &file, const Calculator::Solution &solution);
+}
+
+#endif // RESULTWRITER_H
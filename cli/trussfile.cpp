@@ -0,0 +1,123 @@
+#include "trussfile.h"
+
+#include "jsonkeys.h"
+
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <cmath>
+
+QString TrussFile::load(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return "could not open the file: " + file.errorString();
+    }
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (document.isNull()) {
+        return "the file is no valid json-file: " + error.errorString();
+    }
+    QJsonObject scene = document.object().value(JsonKeys::graphicsView).toObject().value(JsonKeys::graphicsScene).toObject();
+    if (!scene.contains(JsonKeys::items)) {
+        return "the file contains no truss";
+    }
+    double scale = scene.value(JsonKeys::scaleValue).toDouble(100); // [px/m], same default-value as GraphicsScene
+    int savedAnalysisType = scene.value(JsonKeys::analysisType).toInt(static_cast<int>(AnalysisType::Automatic));
+    if (savedAnalysisType < static_cast<int>(AnalysisType::Automatic) || savedAnalysisType > static_cast<int>(AnalysisType::Truss)) {
+        return "the file contains an unknown analysis-type";
+    }
+    analysisType = static_cast<AnalysisType>(savedAnalysisType);
+    loadSteps = qMax(0, scene.value(JsonKeys::loadSteps).toInt(0));
+    bucklingModes = qMax(0, scene.value(JsonKeys::bucklingModes).toInt(0));
+    naturalModes = qMax(0, scene.value(JsonKeys::naturalModes).toInt(0));
+    massMatrix = scene.value(JsonKeys::massMatrix).toInt() == static_cast<int>(MassMatrix::Lumped) ? MassMatrix::Lumped : MassMatrix::Consistent; // like GraphicsScene
+    QJsonArray items = scene.value(JsonKeys::items).toArray();
+    QStringList loadCases;
+    for (const QJsonValue &name : scene.value(JsonKeys::loadCases).toArray()) {
+        loadCases.append(name.toString());
+    }
+    if (!loadCases.isEmpty()) { // files saved before load-cases existed have only the default one
+        model.setLoadCases(loadCases);
+    }
+    for (const QJsonValue &value : scene.value(JsonKeys::loadCombinations).toArray()) {
+        QJsonObject savedCombination = value.toObject();
+        LoadCombination combination;
+        combination.name = savedCombination.value(JsonKeys::name).toString();
+        combination.factors = QVector<double>(model.getLoadCaseCount(), 0);
+        QJsonArray factors = savedCombination.value(JsonKeys::factors).toArray();
+        if (factors.size() > model.getLoadCaseCount()) {
+            return "the load-combination " + combination.name + " has more factors than there are load-cases";
+        }
+        for (int loadCase = 0; loadCase < factors.size(); loadCase++) {
+            combination.factors[loadCase] = factors.at(loadCase).toDouble();
+        }
+        model.loadCombinations.append(combination);
+    }
+
+    // the elements reference each other by the addresses they had when the file was saved
+    QHash<QString, QJsonObject> elements; // address -> element
+    for (const QJsonValue &item : items) {
+        QJsonObject element = item.toObject();
+        elements.insert(element.value(JsonKeys::thisItem).toString(), element);
+    }
+
+    // add the rods and their nodes
+    QHash<QString, int> nodeIndices; // address -> index in the model
+    for (const QJsonValue &item : items) {
+        QJsonObject element = item.toObject();
+        ElementType elementType = static_cast<ElementType>(element.value(JsonKeys::elementType).toInt());
+        if (elementType != ElementType::Rod && elementType != ElementType::Rope) {
+            continue;
+        }
+        int nodes[2];
+        for (int n = 0; n < 2; n++) {
+            QString address = element.value(n == 0 ? JsonKeys::node1 : JsonKeys::node2).toString();
+            if (!nodeIndices.contains(address)) {
+                QJsonObject node = elements.value(address);
+                if (static_cast<ElementType>(node.value(JsonKeys::elementType).toInt(-1)) != ElementType::Node) {
+                    return "the rod " + element.value(JsonKeys::id).toString() + " is not connected to a node";
+                }
+                nodeIndices.insert(address, model.addNode(node.value(JsonKeys::x).toDouble() / scale, node.value(JsonKeys::y).toDouble() / scale,
+                                                          static_cast<NodeType>(node.value(JsonKeys::nodeType).toInt())));
+                nodeIds.append(node.value(JsonKeys::id).toString());
+            }
+            nodes[n] = nodeIndices.value(address);
+        }
+        model.addRod(nodes[0], nodes[1], element.value(JsonKeys::youngsModulus).toDouble(1), element.value(JsonKeys::crossSectionArea).toDouble(1),
+                     element.value(JsonKeys::areaMomentOfInertia).toDouble(1), element.value(JsonKeys::density).toDouble(1), elementType == ElementType::Rope ? RodType::Rope : RodType::Beam); // same default-values as Rod
+        rodIds.append(element.value(JsonKeys::id).toString());
+    }
+    if (model.getRodCount() == 0) {
+        return "there are no rods or nodes";
+    }
+
+    // add the bearings and forces to their nodes
+    for (const QJsonValue &item : items) {
+        QJsonObject element = item.toObject();
+        QString parent = element.value(JsonKeys::parentItem).toString();
+        if (!nodeIndices.contains(parent)) { // not attached to a node of a rod
+            continue;
+        }
+        switch (static_cast<ElementType>(element.value(JsonKeys::elementType).toInt())) {
+        case ElementType::Bearing:
+            model.setBearing(nodeIndices.value(parent), static_cast<BearingType>(element.value(JsonKeys::bearingType).toInt()));
+            break;
+        case ElementType::SingleForce: { // same as Node::getResultingAppliedForce()
+            double value = element.value(JsonKeys::value).toDouble();
+            double angle = element.value(JsonKeys::angle).toDouble(); // [rad]
+            int loadCase = element.value(JsonKeys::loadCase).toInt(0);
+            if (loadCase < 0 || loadCase >= model.getLoadCaseCount()) {
+                return "the force " + element.value(JsonKeys::id).toString() + " belongs to an unknown load-case";
+            }
+            model.addLoad(nodeIndices.value(parent), value * cos(angle), value * sin(angle), 0, loadCase);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return "";
+}
@@ -0,0 +1,26 @@
+#ifndef TRUSSFILE_H
+#define TRUSSFILE_H
+
+#include "calculator.h"
+#include "solver/trussmodel.h"
+
+#include <QString>
+#include <QStringList>
+
+// reads a save-file written by MainWindow::createSaveFileContent() into a TrussModel without constructing any graphics-items
+// like in Calculator::extractModel() only the nodes connected to a rod get added to the model
+struct TrussFile
+{
+    QString load(const QString &filePath); // returns an error-message if the file could not be read, "" otherwise
+
+    TrussModel model;
+    AnalysisType analysisType = AnalysisType::Automatic; // analysis-type saved with the project
+    int loadSteps = 0; // saved with the project, > 0: second-order analysis
+    int bucklingModes = 0; // saved with the project, > 0: buckling analysis
+    int naturalModes = 0; // saved with the project, > 0: modal analysis
+    MassMatrix massMatrix = MassMatrix::Consistent; // saved with the project
+    QStringList nodeIds; // ids of the nodes like shown in the gui, in the order of the nodes in the model
+    QStringList rodIds; // ids of the rods like shown in the gui, in the order of the rods in the model
+};
+
+#endif // TRUSSFILE_H
@@ -4,17 +4,12 @@
 #include "elements/trusselement.h"
 #include "calculator.h"
 #include "pen.h"
+#include "elements/elementtypes.h"
 
 #include <QDebug>
 
 class Node;
 
-enum class BearingType {
-    LocatingBearing = 0,
-    FloatingBearing = 1,
-    FixedClamping = 2
-};
-
 class Bearing : public TrussElement
 {
     Q_OBJECT
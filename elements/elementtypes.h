@@ -0,0 +1,33 @@
+#ifndef ELEMENTTYPES_H
+#define ELEMENTTYPES_H
+
+// these enums are needed by the calculator and the save-file-reader as well, therefore they are declared in this light header (both do not need the graphics-items)
+
+enum class ElementType {
+    Node = 0,
+    Rod = 1,
+    Bearing = 2,
+    SingleForce = 3,
+    Label = 4,
+    Dimension = 5,
+    Rope = 6
+};
+
+enum class NodeType : int {
+    GerberJoint = 0,
+    Weld = 1
+};
+
+enum class RodType : int { // how a rod carries loads, decides its dofs and its ESM (see solver/elementtraits.h)
+    Beam = 0, // euler-bernoulli-beam, normal-force and bending
+    Bar = 1, // normal-force only, a beam in a truss-analysis is computed as a bar
+    Rope = 2 // normal-force only, can only carry tension
+};
+
+enum class BearingType {
+    LocatingBearing = 0,
+    FloatingBearing = 1,
+    FixedClamping = 2
+};
+
+#endif // ELEMENTTYPES_H
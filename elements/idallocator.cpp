@@ -0,0 +1,78 @@
+#include "idallocator.h"
+
+#include <iterator>
+#include <limits>
+
+IdAllocator::IdAllocator() :
+    freeRanges{{1, std::numeric_limits<unsigned long>::max()}}
+{
+}
+
+unsigned long IdAllocator::allocate()
+{
+    auto first = freeRanges.begin(); // the smallest unused id is the beginning of the first range
+    unsigned long id = first->first;
+    unsigned long last = first->second;
+    freeRanges.erase(first);
+    if (id < last) {
+        freeRanges.emplace_hint(freeRanges.begin(), id + 1, last);
+    }
+    return id;
+}
+
+void IdAllocator::release(unsigned long id)
+{
+    if (!isUsed(id)) {
+        return;
+    }
+    if (id == 0) {
+        zeroUsed = false;
+        return;
+    }
+    unsigned long first = id;
+    unsigned long last = id;
+    auto next = freeRanges.upper_bound(id);
+    if (next != freeRanges.end() && next->first == id + 1) { // merge with the range after the id
+        last = next->second;
+        next = freeRanges.erase(next);
+    }
+    if (next != freeRanges.begin()) {
+        auto previous = std::prev(next);
+        if (previous->second + 1 == id) { // merge with the range before the id
+            previous->second = last;
+            return;
+        }
+    }
+    freeRanges.emplace_hint(next, first, last);
+}
+
+bool IdAllocator::reserve(unsigned long id)
+{
+    if (isUsed(id)) {
+        return false;
+    }
+    if (id == 0) {
+        zeroUsed = true;
+        return true;
+    }
+    auto range = std::prev(freeRanges.upper_bound(id)); // the range that contains id, it exists because id is unused
+    unsigned long first = range->first;
+    unsigned long last = range->second;
+    auto next = freeRanges.erase(range);
+    if (id < last) {
+        next = freeRanges.emplace_hint(next, id + 1, last);
+    }
+    if (first < id) {
+        freeRanges.emplace_hint(next, first, id - 1);
+    }
+    return true;
+}
+
+bool IdAllocator::isUsed(unsigned long id) const
+{
+    if (id == 0) {
+        return zeroUsed;
+    }
+    auto next = freeRanges.upper_bound(id);
+    return next == freeRanges.begin() || std::prev(next)->second < id; // unused if the range starting at or before id reaches it
+}
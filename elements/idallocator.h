@@ -0,0 +1,24 @@
+#ifndef IDALLOCATOR_H
+#define IDALLOCATOR_H
+
+#include <map>
+
+// hands out the smallest unused id (starting at 1)
+// the unused ids are stored as disjoint ranges ordered by their first id, allocate(), release() and reserve() are O(log n) in the number of ranges (at most one more
+// than the used ids), therefore creating n elements is not O(n²) and reserving a huge id (e.g. read from a file) costs neither time nor memory proportional to it
+class IdAllocator
+{
+public:
+    explicit IdAllocator();
+
+    unsigned long allocate();
+    void release(unsigned long id);
+    bool reserve(unsigned long id); // marks the specific id as used, returns false if it is used already
+    bool isUsed(unsigned long id) const;
+
+private:
+    std::map<unsigned long, unsigned long> freeRanges; // first unused id -> last unused id of every range, the last range ends at the largest id
+    bool zeroUsed = false; // 0 can only be reserved, it is never handed out, therefore it is not part of the ranges
+};
+
+#endif // IDALLOCATOR_H
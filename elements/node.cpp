@@ -137,11 +137,12 @@ bool Node::hasAppliedForce() const
     return !Utilities::getAllElementsOfType<SingleForce *>(childItems()).isEmpty();
 }
 
-Eigen::Vector2d Node::getResultingAppliedForce() const
+Eigen::Vector2d Node::getResultingAppliedForce(int loadCase) const
 {
     Eigen::Vector2d f(0, 0); // resulting-applied-force-vector (has to be return [0, 0] if no force is applied because the calculator relies on this)
     for (auto child : childItems()) { // search the list of childrens and see if there are forces present, if so add them to the vector
-        if (auto force = dynamic_cast<SingleForce *>(child)) {
+        auto force = dynamic_cast<SingleForce *>(child);
+        if (force != nullptr && force->getLoadCase() == loadCase) {
             f(0) += force->getValue() * cos(force->getAngle()); // fx, positive: right
             f(1) += force->getValue() * sin(force->getAngle()); // fy, positive: up
         }
@@ -149,7 +150,7 @@ Eigen::Vector2d Node::getResultingAppliedForce() const
     return f;
 }
 
-double Node::getResultingAppliedMoment() const // todo: implement!
+double Node::getResultingAppliedMoment(int) const // todo: implement!
 {
     return 0;
 }
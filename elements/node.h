@@ -3,6 +3,7 @@
 
 #include "trusselement.h"
 #include "pen.h"
+#include "elementtypes.h"
 
 #include "libs/Eigen/Eigen/Eigen"
 
@@ -11,16 +12,25 @@ class Bearing;
 class Label;
 class Dimension;
 
-enum class NodeType : int {
-    GerberJoint = 0,
-    Weld = 1
-};
-
 class Node : public TrussElement
 {
     Q_OBJECT
 
 public:
+    struct ResultEnvelope // min/max of the results of the node over all load-combinations, same signs as getUx(), getUy(), getFx(), getFy() and getMz()
+    {
+        double minUx = 0;
+        double maxUx = 0;
+        double minUy = 0;
+        double maxUy = 0;
+        double minFx = 0;
+        double maxFx = 0;
+        double minFy = 0;
+        double maxFy = 0;
+        double minMz = 0;
+        double maxMz = 0;
+    };
+
     explicit Node(); // default ctor
     Node(double xPosition, double yPosition, NodeType type = NodeType::GerberJoint);
     ~Node() override;
@@ -59,12 +69,15 @@ public:
     int getCalcId() const { return calcId; }
 
     bool hasAppliedForce() const;
-    Eigen::Vector2d getResultingAppliedForce() const;
-    double getResultingAppliedMoment() const;
+    Eigen::Vector2d getResultingAppliedForce(int loadCase) const; // only the forces of the given load-case are summed up
+    double getResultingAppliedMoment(int loadCase) const;
 
     double getUx() const;
     double getUy() const;
 
+    void setResultEnvelope(const ResultEnvelope &newEnvelope) { envelope = newEnvelope; }
+    const ResultEnvelope &getResultEnvelope() const { return envelope; }
+
 protected:
     NodeType nodeType;
     Pen pen;
@@ -77,6 +90,7 @@ protected:
     double fx; // positive: right (global) [N]
     double fy; // positive: up [N]
     double mz; // positive: counterclockwise [Nm]
+    ResultEnvelope envelope;
     int calcId;
 
     // TrussElement interface
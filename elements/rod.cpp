@@ -13,9 +13,36 @@
 #include <QDebug>
 #include <QJsonObject>
 
+#include <cmath>
+
 Rod::ColorMap Rod::colorMap = Rod::ColorMap();
 double Rod::maxDisplacement = 0.0;
 
+namespace
+{
+    double shapeFunction(int index, double x, double l) // interpolation-fcts of the beam-element, see Rod::getPhi()
+    {
+        double xi = x / l;
+        switch (index) {
+        case 0:
+            return 1 - 3 * xi * xi + 2 * xi * xi * xi;
+        case 1:
+            return x * (1 - xi) * (1 - xi);
+        case 2:
+            return 3 * xi * xi - 2 * xi * xi * xi;
+        case 3:
+            return x * (xi * xi - xi);
+        case 4:
+            return 1 - xi;
+        case 5:
+            return xi;
+        default:
+            qDebug() << "error in shapeFunction()";
+            return 0;
+        }
+    }
+}
+
 Rod::Rod() :
     TrussElement(0, 0, nullptr),
     node1(nullptr),
@@ -25,12 +52,18 @@ Rod::Rod() :
     label(nullptr), // parent is this, ~QGraphicsItem() deletes it
     calcId(0),
     innerForce(0),
-    dof{-1, -1, -1, -1, -1, -1}, // init dofs with -1 because against this value gets checked if a dof has a valid id (-1 is an invalid id)
+    minInnerForce(0),
+    maxInnerForce(0),
     u{0, 0, 0, 0, 0, 0},
     T(Eigen::Matrix6d::Identity(6, 6)),
     E(1),
     A(1),
-    I(1)
+    I(1),
+    rho(1),
+    localU(Eigen::Vector6d::Zero()),
+    localUIsValid(true),
+    deformationSamplesLength(0),
+    deformationSamplesStep(0)
 {
     setZValue(ElementZValue::Rod_);
 }
@@ -44,12 +77,18 @@ Rod::Rod(Node *elementNode1, Node *elementNode2) :
     label(new Label(id.toString(), 0, 0, this)), // parent is this, ~QGraphicsItem() deletes it
     calcId(0),
     innerForce(0),
-    dof{-1, -1, -1, -1, -1, -1}, // init dofs with -1 because against this value gets checked if a dof has a valid id (-1 is an invalid id)
+    minInnerForce(0),
+    maxInnerForce(0),
     u{0, 0, 0, 0, 0, 0},
     T(Eigen::Matrix6d::Identity(6, 6)),
     E(1),
     A(1),
-    I(1)
+    I(1),
+    rho(1),
+    localU(Eigen::Vector6d::Zero()),
+    localUIsValid(true),
+    deformationSamplesLength(0),
+    deformationSamplesStep(0)
 {
     setZValue(ElementZValue::Rod_);
     if (node1 != nullptr) { // check for null if a nullptr is passed as node1
@@ -156,6 +195,11 @@ void Rod::linkNode2(Node *newNode2)
     node2 = newNode2;
 }
 
+bool Rod::isValidDensity(double density)
+{
+    return std::isfinite(density) && density > 0;
+}
+
 double Rod::getLength() const // returns the length of the rod [m]
 {
     if (node1 != nullptr && node2 != nullptr) {
@@ -178,70 +222,96 @@ double Rod::getAngle() const // this fct returns an angle with a value between [
 
 double Rod::wGraph(double x) const // returns w(x) in local coords
 {
+    const Eigen::Vector6d &localDisplacements = getLocalDisplacements();
+    double l = getLength();
     double wx = 0;
     for (int i = 0; i < 4; i++) {
-        double value = (T.inverse() * Eigen::Map<const Eigen::Vector6d>(u))(i) * getPhi(i, x); // transform global_u to local_u and multiply with interpolation-fct
-        wx += value;
+        wx += localDisplacements(i) * shapeFunction(i, x, l); // multiply local_u with interpolation-fct
     }
     return wx;
 }
 
 double Rod::uGraph(double x) const // returns u(x) in local coords
 {
+    const Eigen::Vector6d &localDisplacements = getLocalDisplacements();
+    double l = getLength();
     double ux = 0;
     for (int i = 4; i < 6; i++) {
-        double value = (T.inverse() * Eigen::Map<const Eigen::Vector6d>(u))(i) * getPhi(i, x);
-        ux += value;
+        ux += localDisplacements(i) * shapeFunction(i, x, l);
     }
     return ux;
 }
 
 double Rod::getPhi(int index, double x) const // returns the value of the interpolation-fct for the given dof at the position x [m] in local coords
+{
+    return shapeFunction(index, x, getLength());
+}
+
+const QVector<Rod::DeformationSample> &Rod::getDeformationSamples(double step) const
 {
     double l = getLength();
-    switch (index) {
-    case 0:
-        return 1 - 3 * pow(x / l, 2) + 2 * pow(x / l, 3);
-    case 1:
-        return x * pow(1 - x / l, 2);
-    case 2:
-        return 3 * pow(x / l, 2) - 2 * pow(x / l, 3);
-    case 3:
-        return x * (pow(x / l, 2) - x / l);
-    case 4:
-        return 1 - x / l;
-    case 5:
-        return x / l;
-    default:
-        qDebug() << "error in Rod::getPhi()";
-        return 0;
+    if (!deformationSamples.isEmpty() && deformationSamplesLength == l && deformationSamplesStep == step) { // exact comparison on purpose, any change invalidates the samples
+        return deformationSamples;
     }
+    const Eigen::Vector6d &localDisplacements = getLocalDisplacements();
+    deformationSamples.clear();
+    for (int t = 0; t <= 100; t += step) { // make t an int but use it as percentage from 0 to 100 %
+        DeformationSample sample{t / 100.0 * l, 0, 0};
+        for (int i = 0; i < 4; i++) {
+            sample.w += localDisplacements(i) * shapeFunction(i, sample.x, l);
+        }
+        for (int i = 4; i < 6; i++) {
+            sample.u += localDisplacements(i) * shapeFunction(i, sample.x, l);
+        }
+        deformationSamples.append(sample);
+    }
+    deformationSamplesLength = l;
+    deformationSamplesStep = step;
+    return deformationSamples;
 }
 
 void Rod::setElementTransformationMatrix(const Eigen::Matrix6d &matrix)
 {
     prepareGeometryChange();
     T = matrix;
+    invalidateDeformationCache();
+}
+
+const Eigen::Vector6d &Rod::getLocalDisplacements() const
+{
+    if (!localUIsValid) {
+        localU.noalias() = T.transpose() * Eigen::Map<const Eigen::Vector6d>(u); // transform global_u to local_u
+        localUIsValid = true;
+    }
+    return localU;
+}
+
+void Rod::invalidateDeformationCache()
+{
+    localUIsValid = false;
+    deformationSamples.clear();
 }
 
 QPainterPath Rod::getDeformedRod() const // returns the deformed shape of the rod with the coord-system origin in node1 and x (y) horizontal (vertical)
 {
     QPainterPath p(QPointF(0, 0));
-    double sv = maxDisplacement == 0 ? 1 : static_cast<GraphicsScene *>(scene())->getMaxDisplacementDistance() / maxDisplacement; // scale graphs to global max u or w
-    double step = static_cast<GraphicsScene *>(scene())->getDisplacementCalculationStep();
-    for (int t = 0; t <= 100; t += step) { // make t an int but use it as percentage from 0 to 100 %
-        Eigen::Vector2d displacement(t / 100.0 * getLength() * static_cast<GraphicsScene *>(scene())->getScaleValue() + uGraph(t / 100.0 * getLength()) * sv,
-                                     - wGraph(t / 100.0 * getLength()) * sv); // displacement = [a (in px) + u(a) * scale, - w(a) * scale]; - y because the y-axis is flipped
-        Eigen::Matrix2d R;
-        R << cos(-getAngle()), - sin(-getAngle()),
-             sin(-getAngle()),   cos(-getAngle()); // rotation matrix for clockwise rotation because for the painter positive y is downwards
+    auto graphicsScene = static_cast<GraphicsScene *>(scene());
+    double sv = maxDisplacement == 0 ? 1 : graphicsScene->getMaxDisplacementDistance() / maxDisplacement; // scale graphs to global max u or w
+    double scaleValue = graphicsScene->getScaleValue();
+    double angle = getAngle();
+    Eigen::Matrix2d R;
+    R << cos(-angle), - sin(-angle),
+         sin(-angle),   cos(-angle); // rotation matrix for clockwise rotation because for the painter positive y is downwards
+    const QVector<DeformationSample> &samples = getDeformationSamples(graphicsScene->getDisplacementCalculationStep());
+    for (int i = 0; i < samples.size(); i++) {
+        Eigen::Vector2d displacement(samples.at(i).x * scaleValue + samples.at(i).u * sv,
+                                     - samples.at(i).w * sv); // displacement = [a (in px) + u(a) * scale, - w(a) * scale]; - y because the y-axis is flipped
         Eigen::Vector2d r = R * displacement; // position vector r = (x, y)
-        if (t == 0) { // move to the first point and connect all other points by a straight line
+        if (i == 0) { // move to the first point and connect all other points by a straight line
             p.moveTo(r(0), r(1));
         } else {
             p.lineTo(r(0), r(1));
         }
-
     }
     return p;
 }
@@ -334,6 +404,10 @@ QJsonObject Rod::saveAsJson() const
     o.insert(JsonKeys::node2, Utilities::convertAddressToString(node2));
     o.insert(JsonKeys::id, getId());
     o.insert(JsonKeys::label, Utilities::convertAddressToString(label));
+    o.insert(JsonKeys::youngsModulus, E);
+    o.insert(JsonKeys::crossSectionArea, A);
+    o.insert(JsonKeys::areaMomentOfInertia, I);
+    o.insert(JsonKeys::density, rho);
     o.insert(JsonKeys::elementType, static_cast<int>(ElementType::Rod));
     return o;
 }
@@ -342,6 +416,10 @@ void Rod::loadFromJson(const QJsonObject &object)
 {
     TrussElement::loadFromJson(object);
     id.resetId(object.value(JsonKeys::id).toString());
+    E = object.value(JsonKeys::youngsModulus).toDouble(1); // files saved before the material was stored fall back to the default-values
+    A = object.value(JsonKeys::crossSectionArea).toDouble(1);
+    I = object.value(JsonKeys::areaMomentOfInertia).toDouble(1);
+    rho = object.value(JsonKeys::density).toDouble(1);
 }
 
 EasyChangeDialog *Rod::createEasyChangeDialog()
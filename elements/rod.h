@@ -41,6 +41,13 @@ protected:
     };
 
 public:
+    struct DeformationSample
+    {
+        double x; // position along the rod in local coords [m]
+        double u; // u(x) [m]
+        double w; // w(x) [m]
+    };
+
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW // this is required for c++14 or lower because of memory-alignment-issues (see http://eigen.tuxfamily.org/dox-devel/group__TopicUnalignedArrayAssert.html)
 
     explicit Rod(); // default ctor
@@ -79,26 +86,31 @@ public:
     double getA() const { return A; } // 0.001106
     void setI(double i) { prepareGeometryChange(); I = i; }
     double getI() const { return I; } // 0.00000171
+    void setDensity(double density) { rho = density; } // only the modal analysis uses it, the drawing does not change
+    double getDensity() const { return rho; } // 7850
+    static bool isValidDensity(double density); // finite and > 0, otherwise the modal analysis gets no real natural frequencies
     double getEA() const { return getE() * getA(); } // [N]
     double getEI() const { return getE() * getI(); } // [Nm²]
     double getLength() const; // [m]
     double getAngle() const; // [rad]
+    virtual RodType getRodType() const { return RodType::Beam; } // decides how the calculator computes the rod, see solver/elementtraits.h
 
     void setInnerForce(double newInnerForce) { innerForce = newInnerForce; } // sets the normal-force in the rod
     double getInnerForce() const { return innerForce; } // returns the normal-force in the rod
+    void setInnerForceEnvelope(double minValue, double maxValue) { minInnerForce = minValue; maxInnerForce = maxValue; } // min/max over all load-combinations
+    double getMinInnerForce() const { return minInnerForce; }
+    double getMaxInnerForce() const { return maxInnerForce; }
 
     void setCalcId(int internCalcId) { calcId = internCalcId; }
     int getCalcId() const { return calcId; }
 
-    void setDOF(int localId, int globalId) { dof[localId] = globalId; }
-    int getDOF(int localId) const { return dof[localId]; }
-
-    void setU(int localId, double value) { prepareGeometryChange(); u[localId] = value; }
+    void setU(int localId, double value) { prepareGeometryChange(); u[localId] = value; invalidateDeformationCache(); }
     double getU(int localId) const { return u[localId]; }
 
     double wGraph(double x) const; // returns w(x)
     double uGraph(double x) const; // returns u(x)
     double getPhi(int index, double x) const; // returns phi(dof, x), where phi_dof is the interpolation-fct to get an approximation for the deformation between the nodes
+    const QVector<DeformationSample> &getDeformationSamples(double step) const; // returns u(x) and w(x) at x = t / 100 * length for t = 0, step, ..., 100 (cached until u, T, the length or step change)
 
     void setElementTransformationMatrix(const Eigen::Matrix6d &matrix);
     Eigen::Matrix6d getElementTransformationMatrix() const { return T; }
@@ -117,13 +129,26 @@ protected:
     Label *label; // this is parent
     int calcId;
     double innerForce;
-    int dof[6]; // y1, m1, y2, m2, x1, x2 in global (x right, y up, m counterclockwise positive) coords (index 1: node1, index2: node2)
-    double u[6]; // y1, m1, y2, m2, x1, x2 in global coords
+    double minInnerForce;
+    double maxInnerForce;
+    double u[6]; // y1, m1, y2, m2, x1, x2 in global (x right, y up, m counterclockwise positive) coords (index 1: node1, index2: node2)
     Eigen::Matrix6d T; // element-transformation-matrix
     static double maxDisplacement; // [px]
     double E; // young's modulus [N/m²]
     double A; // cross-section area [m²]
     double I; // area-moment of inertia [m^4]
+    double rho; // density [kg/m³]
+
+private:
+    const Eigen::Vector6d &getLocalDisplacements() const; // returns T^T * u (T is orthogonal, so no inverse is needed)
+    void invalidateDeformationCache();
+
+    // the deformation is sampled for every frame and every rod, therefore the local displacements and the samples are cached
+    mutable Eigen::Vector6d localU;
+    mutable bool localUIsValid;
+    mutable QVector<DeformationSample> deformationSamples;
+    mutable double deformationSamplesLength; // length and step the samples were calculated with
+    mutable double deformationSamplesStep;
 
     // QGraphicsItem interface
 public:
@@ -1,5 +1,9 @@
 #include "rope.h"
 
+#include "jsonkeys.h"
+
+#include <QJsonObject>
+
 Rope::Rope() :
     Rod()
 {
@@ -11,3 +15,10 @@ Rope::Rope(Node *elementNode1, Node *elementNode2) :
 {
     pen.setWidth(3);
 }
+
+QJsonObject Rope::saveAsJson() const
+{
+    QJsonObject o(Rod::saveAsJson());
+    o.insert(JsonKeys::elementType, static_cast<int>(ElementType::Rope)); // everything else is stored like a rod
+    return o;
+}
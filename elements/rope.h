@@ -18,6 +18,12 @@ public:
     Rope(Rope &&) = delete;
     Rope &operator =(const Rope &) = delete;
     Rope &operator =(Rope &&) = delete;
+
+    RodType getRodType() const override { return RodType::Rope; } // no bending-stiffness, only tension
+
+    // TrussElement interface
+public:
+    QJsonObject saveAsJson() const override;
 };
 
 #endif // ROPE_H
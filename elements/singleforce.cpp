@@ -18,6 +18,7 @@ SingleForce::SingleForce(Node *parentNode, double elementValue, double elementAn
     length(100),
     value(elementValue),
     angle(elementAngle),
+    loadCase(0),
     id(Id<SingleForce>())
 {
     setFlag(QGraphicsItem::ItemStacksBehindParent);
@@ -59,6 +60,7 @@ QJsonObject SingleForce::saveAsJson() const
     QJsonObject o(TrussElement::saveAsJson());
     o.insert(JsonKeys::value, value);
     o.insert(JsonKeys::angle, angle);
+    o.insert(JsonKeys::loadCase, loadCase);
     o.insert(JsonKeys::id, getId());
     o.insert(JsonKeys::elementType, static_cast<int>(ElementType::SingleForce));
     return o;
@@ -69,6 +71,7 @@ void SingleForce::loadFromJson(const QJsonObject &object)
     TrussElement::loadFromJson(object);
     value = object.value(JsonKeys::value).toDouble();
     angle = object.value(JsonKeys::angle).toDouble();
+    loadCase = object.value(JsonKeys::loadCase).toInt(0); // files saved before load-cases existed have all forces in the first one
     id.resetId(object.value(JsonKeys::id).toString());
 }
 
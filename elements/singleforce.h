@@ -25,6 +25,9 @@ public:
     void setAngle(double newAngle);
     double getAngle() const { return angle; }
 
+    void setLoadCase(int newLoadCase) { loadCase = newLoadCase; }
+    int getLoadCase() const { return loadCase; } // index of the load-case in GraphicsScene::getLoadCases()
+
 private:
     Pen pen;
     int arrowWidth; // [px]
@@ -32,6 +35,7 @@ private:
     int length; // [px]
     double value; // [N]
     double angle; // [rad], 0 = right, positive = counterclockwise
+    int loadCase;
     Id<SingleForce> id;
 
     // TrussElement interface
@@ -1,6 +1,7 @@
 #include "trusselement.h"
 
 #include "graphicsscene.h"
+#include "spatialindex.h"
 #include "widgets/easychange/easychangedialog.h"
 #include "jsonkeys.h"
 
@@ -17,13 +18,20 @@ TrussElement::TrussElement(double xPosition, double yPosition, TrussElement *par
     isUnderHoverAction(false)
 {
     setAcceptHoverEvents(true);
+    setFlag(QGraphicsItem::ItemSendsGeometryChanges); // otherwise itemChange() is not called when the position changes
     setX(xPosition);
     setY(yPosition);
+    if (SpatialIndex *index = getSpatialIndex()) { // an element constructed with a parent that is already on a scene does not get an ItemSceneHasChanged-notification in this class
+        index->insert(this);
+    }
 }
 
 TrussElement::~TrussElement()
 {
     closeEasyChangeDialog(); // within this fct it is examined if the dialog belongs to this element, if not the dialog is not closed
+    if (SpatialIndex *index = getSpatialIndex()) { // ~QGraphicsItem() removes the element from the scene without calling itemChange() of this class
+        index->remove(this);
+    }
     // the children get removed and deleted in ~QGraphicsItem()
 }
 
@@ -138,6 +146,59 @@ void TrussElement::loadFromJson(const QJsonObject &object)
     setZValue(object.value(JsonKeys::zValue).toDouble());
 }
 
+void TrussElement::prepareGeometryChange()
+{
+    QGraphicsObject::prepareGeometryChange();
+    markSpatialIndexDirty(false);
+}
+
+SpatialIndex *TrussElement::getSpatialIndex() const
+{
+    if (scene() == nullptr) {
+        return nullptr;
+    }
+    return static_cast<GraphicsScene *>(scene())->getSpatialIndex();
+}
+
+void TrussElement::markSpatialIndexDirty(bool includeChildren)
+{
+    if (SpatialIndex *index = getSpatialIndex()) {
+        index->markDirty(this);
+    }
+    if (includeChildren) {
+        for (auto child : Utilities::getAllElementsOfType<TrussElement *>(childItems())) {
+            child->markSpatialIndexDirty(true);
+        }
+    }
+}
+
+QVariant TrussElement::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+    switch (change) {
+    case ItemSceneChange: // the element is about to leave its current scene
+        if (SpatialIndex *index = getSpatialIndex()) {
+            index->remove(this);
+        }
+        break;
+    case ItemSceneHasChanged:
+    case ItemParentHasChanged: // a reparented element is stacked above its new siblings, insert() renews the stacking order
+        if (SpatialIndex *index = getSpatialIndex()) {
+            index->insert(this);
+        }
+        markSpatialIndexDirty(true);
+        break;
+    case ItemPositionHasChanged:
+    case ItemTransformHasChanged:
+    case ItemRotationHasChanged:
+    case ItemScaleHasChanged:
+        markSpatialIndexDirty(true); // the children move together with this element
+        break;
+    default:
+        break;
+    }
+    return QGraphicsObject::itemChange(change, value);
+}
+
 void TrussElement::mousePressEvent(QGraphicsSceneMouseEvent *event)
 {
     if (event->buttons() == Qt::LeftButton) {
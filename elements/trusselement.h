@@ -3,6 +3,8 @@
 
 #include "color.h"
 #include "utilities.h"
+#include "elementtypes.h"
+#include "idallocator.h"
 
 #include <QGraphicsObject>
 #include <QGraphicsSceneMouseEvent>
@@ -10,15 +12,7 @@
 
 class Color;
 class EasyChangeDialog;
-
-enum class ElementType {
-    Node = 0,
-    Rod = 1,
-    Bearing = 2,
-    SingleForce = 3,
-    Label = 4,
-    Dimension = 5
-};
+class SpatialIndex;
 
 enum ElementZValue { // no enum class to reduce the amount of type-casting
     Dimension_ = 0,
@@ -36,8 +30,8 @@ template<typename T>
 class Id
 {
 public:
-    Id() : id(generateId()) {} // set id to a new value
-    ~Id() { usedIds.removeOne(id); } // free id in dtor
+    Id() : id(allocator.allocate()) {} // set id to a new value
+    ~Id() { allocator.release(id); } // free id in dtor
 
     QString toString() const { return QString::number(id); } // return id as string
 
@@ -46,32 +40,21 @@ public:
         if (id == newIdString.toUInt()) {
             return; // the current id is also the new id, therefore do nothing
         }
-        usedIds.removeOne(id); // unregister current id
-        if (usedIds.contains(newIdString.toUInt())) {
+        allocator.release(id); // unregister current id
+        if (!allocator.reserve(newIdString.toUInt())) { // register new id to prevent double-assignment of the same id
             qFatal("error 1 in Id(QString): id is used already");
         } else {
             id = newIdString.toUInt(); // assign new id
-            Utilities::insertSorted(id, usedIds); // register new id to prevent double-assignment of the same id
         }
     }
 
 private:
-    unsigned long generateId()
-    {
-        unsigned long newId = 1;
-        while (usedIds.contains(newId)) { // find first free id (usedIds does not contain it)
-            newId++;
-        }
-        usedIds.append(newId); // mark the new id as used
-        return newId;
-    }
-
     unsigned long id;
-    static QVector<unsigned long> usedIds;
+    static IdAllocator allocator; // one allocator per element-type, so every type has its own ids
 };
 
 template<typename T>
-QVector<unsigned long> Id<T>::usedIds;
+IdAllocator Id<T>::allocator;
 
 class TrussElement : public QGraphicsObject
 {
@@ -123,12 +106,19 @@ protected:
     bool isUnderHoverAction;
     static EasyChangeDialog *easyChangeDialog;
 
+    void prepareGeometryChange(); // hides QGraphicsItem::prepareGeometryChange() so that every change of the br also updates the spatial-index of the scene
+
+private:
+    SpatialIndex *getSpatialIndex() const; // returns weak ptr to the index of the scene or nullptr if the element is not on a scene
+    void markSpatialIndexDirty(bool includeChildren);
+
     // QGraphicsItem interface
 public:
     QRectF boundingRect() const override = 0;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override = 0;
 
 protected:
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
     void mouseMoveEvent(QGraphicsSceneMouseEvent *event) override;
     void mouseReleaseEvent(QGraphicsSceneMouseEvent *event) override;
@@ -2,6 +2,7 @@
 
 #include "elements/singleforce.h"
 #include "elements/node.h"
+#include "graphicsscene.h"
 #include "utilities.h"
 
 ForceAdder::ForceAdder()
@@ -15,6 +16,7 @@ void ForceAdder::mouseClicked(QGraphicsSceneMouseEvent *event, Node *node)
             return;
         } else { // create new bearing and add it to the scene
             auto force = new SingleForce(node); // the ownership is passed to the node (=parent) (the item is automatically added to the scene by the node)
+            force->setLoadCase(static_cast<GraphicsScene *>(node->scene())->getActiveLoadCase()); // new forces belong to the load-case that is shown
             force->showEasyChangeDialog(); // show its dialog
         }
     }
@@ -1,13 +1,15 @@
 #include "rodadder.h"
 
 #include "elements/rod.h"
+#include "elements/rope.h"
 #include "elements/node.h"
 #include "graphicsscene.h"
 
 #include <QDebug>
 
-RodAdder::RodAdder(GraphicsScene *graphicsScene) :
+RodAdder::RodAdder(GraphicsScene *graphicsScene, RodType type) :
     scene(graphicsScene),
+    rodType(type),
     rod(nullptr),
     node1(nullptr),
     virtualNode(nullptr)
@@ -84,7 +86,7 @@ void RodAdder::createRod() {
     if (rod != nullptr) {
         qDebug() << "Error2 in RodAdder occured";
     }
-    rod = new Rod(node1, virtualNode); // gets temporarily (or permanently) added to the scene and is deleted if the user aborts the adding of rods
+    rod = rodType == RodType::Rope ? new Rope(node1, virtualNode) : new Rod(node1, virtualNode); // gets temporarily (or permanently) added to the scene and is deleted if the user aborts the adding of rods
     scene->addItem(rod); // add rod to scene immediately after creation (for memory-management-reasons)
 }
 
@@ -1,6 +1,8 @@
 #ifndef RODADDER_H
 #define RODADDER_H
 
+#include "elements/elementtypes.h"
+
 #include <QGraphicsSceneMouseEvent>
 
 class Rod;
@@ -10,7 +12,7 @@ class GraphicsScene;
 class RodAdder final
 {
 public:
-    explicit RodAdder(GraphicsScene *graphicsScene);
+    explicit RodAdder(GraphicsScene *graphicsScene, RodType type = RodType::Beam); // type: Beam or Rope
     ~RodAdder();
     // prevent copying or moving this class (because how would a copy look like and since it is not necessary to move it around there is no need to implement the move-operation)
     RodAdder(const RodAdder &) = delete;
@@ -29,6 +31,7 @@ public:
 
 private:
     GraphicsScene *scene; // weak ptr
+    RodType rodType; // kind of the created rods
     Rod *rod; // weak ptr as long as it is added to the scene
     Node *node1; // weak ptr
     Node *virtualNode; // weak ptr as long as it is added to the scene
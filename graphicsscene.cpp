@@ -8,6 +8,7 @@
 #include "factories/forceadder.h"
 #include "factories/dimensionadder.h"
 #include "elements/rod.h"
+#include "elements/rope.h"
 #include "utilities.h"
 #include "calculator.h"
 #include "widgets/mainwindow.h"
@@ -17,12 +18,20 @@
 #include "elements/label.h"
 #include "elements/dimension.h"
 #include "factories/labeladder.h"
+#include "solver/linearsolver.h"
+#include "solver/dofordering.h"
+#include "solver/calculationservice.h"
+#include "spatialindex.h"
 
 #include <QGraphicsSceneMouseEvent>
 #include <QCursor>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QPair>
+#include <QHash>
+#include <QElapsedTimer>
+
+#include <algorithm>
 
 GraphicsScene::GraphicsScene(MainWindow *parent) :
     QGraphicsScene(parent),
@@ -35,10 +44,28 @@ GraphicsScene::GraphicsScene(MainWindow *parent) :
     scaleValue(100),
     clickInEmptySceneSpace(false),
     maxDisplacementDistance(20.0),
-    displacementCalculationStep(10.0)
+    displacementCalculationStep(10.0),
+    sparseAssemblyThreshold(200),
+    solverBackend(SolverBackend::Automatic),
+    dofOrdering(DofOrdering::ApproximateMinimumDegree),
+    maxLowRankUpdates(32),
+    threadCount(0),
+    analysisType(AnalysisType::Automatic),
+    loadSteps(0),
+    bucklingModes(0),
+    naturalModes(0),
+    massMatrix(MassMatrix::Consistent),
+    calculationService(std::make_unique<CalculationService>(this)),
+    spatialIndex(std::make_unique<SpatialIndex>()),
+    loadCases({"Lastfall 1"}),
+    activeLoadCase(0),
+    shownResult(showActiveLoadCase),
+    shownModeShape(showDeformation)
 {
+    connect(calculationService.get(), &CalculationService::calculationFinished, this, &GraphicsScene::showCalculationResults);
     // with the default index-method a SIGSEGV-error occurs when an item gets removed via removeItem and the deleted, because event if the item is removed from the scene,
     // the BSP-tree keeps a ptr to it and on the next redraw of the scene it dereferences the ptr which causes a crash, therefore use no item-indexing
+    // (hit-testing uses the own spatial-index instead, see getElements())
     setItemIndexMethod(QGraphicsScene::NoIndex);
 }
 
@@ -50,94 +77,165 @@ GraphicsScene::GraphicsScene(const QJsonObject &object, MainWindow *parent) :
     forceAdder(nullptr),
     dimensionAdder(nullptr),
     labelAdder(nullptr),
-    scaleValue(100),
+    scaleValue(object.value(JsonKeys::scaleValue).toDouble(100)), // files saved before the scale was stored use the default-value
     maxDisplacementDistance(20.0),
-    displacementCalculationStep(10.0)
+    displacementCalculationStep(10.0),
+    sparseAssemblyThreshold(200),
+    solverBackend(SolverBackend::Automatic),
+    dofOrdering(DofOrdering::ApproximateMinimumDegree),
+    maxLowRankUpdates(32),
+    threadCount(0),
+    analysisType(AnalysisType::Automatic),
+    loadSteps(0),
+    bucklingModes(0),
+    naturalModes(0),
+    massMatrix(MassMatrix::Consistent),
+    calculationService(std::make_unique<CalculationService>(this)),
+    spatialIndex(std::make_unique<SpatialIndex>()),
+    loadCases({"Lastfall 1"}), // files saved before load-cases existed have only this one
+    activeLoadCase(0),
+    shownResult(showActiveLoadCase),
+    shownModeShape(showDeformation)
 {
+    connect(calculationService.get(), &CalculationService::calculationFinished, this, &GraphicsScene::showCalculationResults);
     setItemIndexMethod(QGraphicsScene::NoIndex);
+    QStringList savedLoadCases;
+    for (auto name : object.value(JsonKeys::loadCases).toArray()) {
+        savedLoadCases.append(name.toString());
+    }
+    if (!savedLoadCases.isEmpty()) {
+        loadCases = savedLoadCases;
+    }
+    for (auto value : object.value(JsonKeys::loadCombinations).toArray()) {
+        QJsonObject savedCombination = value.toObject();
+        LoadCombination combination;
+        combination.name = savedCombination.value(JsonKeys::name).toString();
+        combination.factors = QVector<double>(loadCases.size(), 0);
+        QJsonArray factors = savedCombination.value(JsonKeys::factors).toArray();
+        for (int loadCase = 0; loadCase < qMin(factors.size(), loadCases.size()); loadCase++) {
+            combination.factors[loadCase] = factors.at(loadCase).toDouble();
+        }
+        loadCombinations.append(combination);
+    }
+    int savedAnalysisType = object.value(JsonKeys::analysisType).toInt(static_cast<int>(AnalysisType::Automatic)); // files saved before it existed have none
+    if (savedAnalysisType >= static_cast<int>(AnalysisType::Automatic) && savedAnalysisType <= static_cast<int>(AnalysisType::Truss)) { // an unknown type stays automatic
+        analysisType = static_cast<AnalysisType>(savedAnalysisType);
+    }
+    loadSteps = qMax(0, object.value(JsonKeys::loadSteps).toInt(0));
+    bucklingModes = qMax(0, object.value(JsonKeys::bucklingModes).toInt(0));
+    naturalModes = qMax(0, object.value(JsonKeys::naturalModes).toInt(0));
+    massMatrix = object.value(JsonKeys::massMatrix).toInt() == static_cast<int>(MassMatrix::Lumped) ? MassMatrix::Lumped : MassMatrix::Consistent;
+    QElapsedTimer loadTimer; // the loading-time gets reported for large files
+    loadTimer.start();
     // firstly create the elements (with nullptrs as member-ptrs), then link them together (set the member-ptrs to the correct address)
     auto elements = object.value(JsonKeys::items).toArray();
+    QVector<QJsonObject> objects; // parse every element only once
+    objects.reserve(elements.size());
     QList<QPair<QString, TrussElement *>> memoryMap; // this map holds pairs of the old-address (= loaded from file) and the new-address (= new constructed) of an element
+    memoryMap.reserve(elements.size());
     // construct every element
     for (auto element : elements) {
-        switch (static_cast<ElementType>(element.toObject().value(JsonKeys::elementType).toInt())) {
+        objects.append(element.toObject());
+        switch (static_cast<ElementType>(objects.last().value(JsonKeys::elementType).toInt())) {
         case ElementType::Node:
-            setupElementFromJson<Node>(element, memoryMap);
+            setupElementFromJson<Node>(objects.last(), memoryMap);
             break;
         case ElementType::Rod:
-            setupElementFromJson<Rod>(element, memoryMap);
+            setupElementFromJson<Rod>(objects.last(), memoryMap);
+            break;
+        case ElementType::Rope:
+            setupElementFromJson<Rope>(objects.last(), memoryMap);
             break;
         case ElementType::Bearing:
-            setupElementFromJson<Bearing>(element, memoryMap);
+            setupElementFromJson<Bearing>(objects.last(), memoryMap);
             break;
         case ElementType::SingleForce:
-            setupElementFromJson<SingleForce>(element, memoryMap);
+            setupElementFromJson<SingleForce>(objects.last(), memoryMap);
             break;
         case ElementType::Label:
-            setupElementFromJson<Label>(element, memoryMap);
+            setupElementFromJson<Label>(objects.last(), memoryMap);
             break;
         case ElementType::Dimension:
-            setupElementFromJson<Dimension>(element, memoryMap);
+            setupElementFromJson<Dimension>(objects.last(), memoryMap);
             break;
         default:
             qFatal("error 1 in GraphicsScene::GraphicsScene(QJsonObject, MainWindow) occured: invalid element-type");
         }
     }
-    // link elements together
-    for (auto pair : memoryMap) { // loop through every pair (oldAddress, newAddress (= ptr-to-object))
-        for (int i = 0; i < elements.size(); i++) { // check every element if it has the current oldAddress as a member-ptr
-            auto e = elements.at(i).toObject();
-            if (pair.first == e.value(JsonKeys::parentItem).toString()) { // if the oldAddress equals a parent's oldAddress, then set the parent to the newAddress
-                memoryMap.at(i).second->setParentItem(pair.second);
-            } // no else-case because a element can be a parent and a member of an element
-            switch (static_cast<ElementType>(e.value(JsonKeys::elementType).toInt())) { // switch the execution-path depending on the type of the element (to call different fcts)
-            case ElementType::Rod:
-                if (pair.first == e.value(JsonKeys::label).toString()) { // if the oldAddress is the rod's label, set the rod's member-ptr to the newAddress of the same label
-                    static_cast<Rod *>(memoryMap.at(i).second)->setLabel(static_cast<Label *>(pair.second)); // memoryMap and elements have the same order
-                } else if (pair.first == e.value(JsonKeys::node1).toString()) { // check if the element at the oldAddress is the node1 of the rod
-                    static_cast<Rod *>(memoryMap.at(i).second)->linkNode1(static_cast<Node *>(pair.second)); // if so set the member-ptr to the newAddress of the same element
-                } else if (pair.first == e.value(JsonKeys::node2).toString()) {
-                    static_cast<Rod *>(memoryMap.at(i).second)->linkNode2(static_cast<Node *>(pair.second));
-                }
-                break;
-            case ElementType::Node:
-                if (pair.first == e.value(JsonKeys::label).toString()) { // check for label
-                    static_cast<Node *>(memoryMap.at(i).second)->setLabel(static_cast<Label *>(pair.second));
-                } else {
-                    for (auto rod : e.value(JsonKeys::rods).toArray()) { // loop through the array of rod-address-strings and check if one matches the oldAddress of the current pair
-                        if (pair.first == rod.toString()) {
-                            static_cast<Node *>(memoryMap.at(i).second)->addRod(static_cast<Rod *>(pair.second));
-                        }
-                    }
-                }
-                break;
-            case ElementType::Bearing:
-                // nothing to link
-                break;
-            case ElementType::SingleForce:
-                // nothing to link
-                break;
-            case ElementType::Label:
-                // nothing to link
-                break;
-            case ElementType::Dimension:
-                if (pair.first == e.value(JsonKeys::label).toString()) { // see rod for comments
-                    static_cast<Dimension *>(memoryMap.at(i).second)->setLabel(static_cast<Label *>(pair.second));
-                } else if (pair.first == e.value(JsonKeys::node1).toString()) {
-                    static_cast<Dimension *>(memoryMap.at(i).second)->linkNode1(static_cast<Node *>(pair.second));
-                } else if (pair.first == e.value(JsonKeys::node2).toString()) {
-                    static_cast<Dimension *>(memoryMap.at(i).second)->linkNode2(static_cast<Node *>(pair.second));
+    qint64 constructionTime = loadTimer.elapsed();
+    // link elements together, every member-ptr (oldAddress) of an element is looked up in a hash, therefore every element gets visited only once
+    QHash<QString, TrussElement *> newAddresses; // oldAddress -> newAddress (= ptr-to-object)
+    newAddresses.reserve(memoryMap.size());
+    for (auto pair : memoryMap) {
+        newAddresses.insert(pair.first, pair.second);
+    }
+    for (int i = 0; i < objects.size(); i++) {
+        const QJsonObject &e = objects.at(i);
+        TrussElement *element = memoryMap.at(i).second; // memoryMap and elements have the same order
+        if (auto parentElement = newAddresses.value(e.value(JsonKeys::parentItem).toString())) { // set the parent to the newAddress of the parent's oldAddress
+            element->setParentItem(parentElement);
+        }
+        switch (static_cast<ElementType>(e.value(JsonKeys::elementType).toInt())) { // switch the execution-path depending on the type of the element (to call different fcts)
+        case ElementType::Rod:
+        case ElementType::Rope: // a rope links like a rod
+            if (auto label = newAddresses.value(e.value(JsonKeys::label).toString())) { // set the rod's member-ptr to the newAddress of its label
+                static_cast<Rod *>(element)->setLabel(static_cast<Label *>(label));
+            }
+            if (auto node1 = newAddresses.value(e.value(JsonKeys::node1).toString())) {
+                static_cast<Rod *>(element)->linkNode1(static_cast<Node *>(node1));
+            }
+            if (auto node2 = newAddresses.value(e.value(JsonKeys::node2).toString())) {
+                static_cast<Rod *>(element)->linkNode2(static_cast<Node *>(node2));
+            }
+            break;
+        case ElementType::Node:
+            if (auto label = newAddresses.value(e.value(JsonKeys::label).toString())) {
+                static_cast<Node *>(element)->setLabel(static_cast<Label *>(label));
+            }
+            for (auto rod : e.value(JsonKeys::rods).toArray()) { // loop through the array of rod-address-strings
+                if (auto newRod = newAddresses.value(rod.toString())) {
+                    static_cast<Node *>(element)->addRod(static_cast<Rod *>(newRod));
                 }
-                break;
-            default:
-                qFatal("error 2 in GraphicsScene::GraphicsScene(QJsonObject, MainWindow) occured: invalid element-type");
             }
+            break;
+        case ElementType::Bearing:
+            // nothing to link
+            break;
+        case ElementType::SingleForce:
+            // nothing to link
+            break;
+        case ElementType::Label:
+            // nothing to link
+            break;
+        case ElementType::Dimension:
+            if (auto label = newAddresses.value(e.value(JsonKeys::label).toString())) { // see rod for comments
+                static_cast<Dimension *>(element)->setLabel(static_cast<Label *>(label));
+            }
+            if (auto node1 = newAddresses.value(e.value(JsonKeys::node1).toString())) {
+                static_cast<Dimension *>(element)->linkNode1(static_cast<Node *>(node1));
+            }
+            if (auto node2 = newAddresses.value(e.value(JsonKeys::node2).toString())) {
+                static_cast<Dimension *>(element)->linkNode2(static_cast<Node *>(node2));
+            }
+            break;
+        default:
+            qFatal("error 2 in GraphicsScene::GraphicsScene(QJsonObject, MainWindow) occured: invalid element-type");
+        }
+    }
+    updateLoadCaseVisibility();
+    if (elements.size() >= 1000) { // only report the loading-time of large files
+        qint64 loadTime = loadTimer.elapsed();
+        QString message = QString("%1 Elemente in %2 ms geladen (davon %3 ms zum Verknüpfen)").arg(elements.size()).arg(loadTime).arg(loadTime - constructionTime);
+        qInfo().noquote() << message;
+        if (parent != nullptr) {
+            parent->setStatusBarMessage(message);
         }
     }
 }
 
 GraphicsScene::~GraphicsScene() // the items that the scene contains get deleted within ~QGraphicsScene()
 {
+    calculationService.reset(); // stop the worker-thread before the items get deleted
     // close any open adder
     if (nodeAdder != nullptr) {
         nodeAdder.reset();
@@ -152,27 +250,23 @@ GraphicsScene::~GraphicsScene() // the items that the scene contains get deleted
     } else if (labelAdder != nullptr) {
         labelAdder.reset();
     }
+    clear(); // delete the items while the spatial-index still exists because they unregister themselves in ~TrussElement()
 }
 
 QList<TrussElement *> GraphicsScene::getElements(const QPointF &point) const
 {
-    QList<TrussElement *> list;
-    for (TrussElement *element : Utilities::convertTo<TrussElement *>(items())) {
-        if (element->contains(element->mapFromScene(point))) {
-            list.append(element);
-        }
-    }
+    QList<TrussElement *> list = spatialIndex->getElements(point);
+    std::sort(list.begin(), list.end(), [this](TrussElement *a, TrussElement *b) { return spatialIndex->isAbove(a, b); }); // topmost element first, like items()
     return list;
 }
 
 TrussElement *GraphicsScene::getElementAt(const QPointF &point) const
 {
-    for (TrussElement *element : Utilities::convertTo<TrussElement *>(items())) {
-        if (element->contains(element->mapFromScene(point))) {
-            return element;
-        }
+    QList<TrussElement *> list = spatialIndex->getElements(point);
+    if (list.isEmpty()) {
+        return nullptr;
     }
-    return nullptr;
+    return *std::min_element(list.begin(), list.end(), [this](TrussElement *a, TrussElement *b) { return spatialIndex->isAbove(a, b); }); // return the topmost element
 }
 
 Node *GraphicsScene::getNodeAt(const QPointF &point) const
@@ -214,6 +308,7 @@ void GraphicsScene::removeElementAt(const QPointF &point)
 
 void GraphicsScene::clearScene()
 {
+    calculationService->cancel(); // the solution of a running calculation belongs to the deleted items
     removeElement(Utilities::convertTo<TrussElement *>(items()));
 }
 
@@ -242,6 +337,15 @@ void GraphicsScene::addRod(bool checked)
     }
 }
 
+void GraphicsScene::addRope(bool checked)
+{
+    if (checked) {
+        rodAdder = std::make_unique<RodAdder>(this, RodType::Rope);
+    } else {
+        rodAdder.reset(nullptr);
+    }
+}
+
 void GraphicsScene::addBearing(bool checked)
 {
     if (checked) {
@@ -303,7 +407,23 @@ QJsonObject GraphicsScene::saveAsJson() const
     for (auto element : Utilities::convertTo<TrussElement *>(items())) {
         a.append(element->saveAsJson());
     }
-    return {QPair<QString, QJsonValue>(JsonKeys::items, a)};
+    QJsonArray combinations;
+    for (const LoadCombination &combination : loadCombinations) {
+        QJsonArray factors;
+        for (double factor : combination.factors) {
+            factors.append(factor);
+        }
+        combinations.append(QJsonObject{QPair<QString, QJsonValue>(JsonKeys::name, combination.name), QPair<QString, QJsonValue>(JsonKeys::factors, factors)});
+    }
+    return {QPair<QString, QJsonValue>(JsonKeys::scaleValue, scaleValue),
+            QPair<QString, QJsonValue>(JsonKeys::loadCases, QJsonArray::fromStringList(loadCases)),
+            QPair<QString, QJsonValue>(JsonKeys::loadCombinations, combinations),
+            QPair<QString, QJsonValue>(JsonKeys::analysisType, static_cast<int>(analysisType)),
+            QPair<QString, QJsonValue>(JsonKeys::loadSteps, loadSteps),
+            QPair<QString, QJsonValue>(JsonKeys::bucklingModes, bucklingModes),
+            QPair<QString, QJsonValue>(JsonKeys::naturalModes, naturalModes),
+            QPair<QString, QJsonValue>(JsonKeys::massMatrix, static_cast<int>(massMatrix)),
+            QPair<QString, QJsonValue>(JsonKeys::items, a)};
 }
 
 void GraphicsScene::setScaleValue(double newScaleValue)
@@ -319,6 +439,63 @@ void GraphicsScene::setScaleValue(double newScaleValue)
     }
 }
 
+void GraphicsScene::setAnalysisType(AnalysisType type)
+{
+    if (type != analysisType) {
+        analysisType = type;
+        requestCalculation(); // the numbering of the dofs changes, therefore the cached factorization gets replaced
+    }
+}
+
+void GraphicsScene::setLoadSteps(int steps)
+{
+    steps = qMax(0, steps);
+    if (steps != loadSteps) {
+        loadSteps = steps;
+        requestCalculation(); // the factorization stays valid, only the results change
+    }
+}
+
+void GraphicsScene::setBucklingModes(int modes)
+{
+    modes = qMax(0, modes);
+    if (modes != bucklingModes) {
+        bucklingModes = modes;
+        requestCalculation(); // the factorization stays valid, only the buckling analysis is added or changed
+    }
+}
+
+int GraphicsScene::getBucklingColumn() const
+{
+    return shownResult >= 0 ? loadCases.size() + shownResult : activeLoadCase; // the columns of the combinations follow the ones of the load-cases
+}
+
+void GraphicsScene::setNaturalModes(int modes)
+{
+    modes = qMax(0, modes);
+    if (modes != naturalModes) {
+        naturalModes = modes;
+        requestCalculation(); // the factorization stays valid, only the modal analysis is added or changed
+    }
+}
+
+void GraphicsScene::setMassMatrix(MassMatrix type)
+{
+    if (type != massMatrix) {
+        massMatrix = type;
+        requestCalculation();
+    }
+}
+
+void GraphicsScene::setShownModeShape(int mode)
+{
+    if (mode < showDeformation || mode == shownModeShape) {
+        return;
+    }
+    shownModeShape = mode;
+    calculationService->reapplySolution(); // the modes are part of the solution
+}
+
 void GraphicsScene::setMaxDisplacementDistance(double d)
 {
     for (auto rod : Utilities::getAllElementsOfType<Rod *>(items())) {
@@ -327,12 +504,105 @@ void GraphicsScene::setMaxDisplacementDistance(double d)
     maxDisplacementDistance = d;
 }
 
+int GraphicsScene::addLoadCase(const QString &name)
+{
+    loadCases.append(name);
+    for (LoadCombination &combination : loadCombinations) {
+        combination.factors.resize(loadCases.size()); // the new load-case is not part of any combination yet
+    }
+    requestCalculation(); // the solution has to get a column for the new load-case
+    return loadCases.size() - 1;
+}
+
+void GraphicsScene::renameLoadCase(int loadCase, const QString &name)
+{
+    loadCases.replace(loadCase, name);
+}
+
+void GraphicsScene::removeLoadCase(int loadCase)
+{
+    if (loadCases.size() <= 1) {
+        return;
+    }
+    if (auto element = getEasyChangeDialogElement()) { // the dialog could belong to a force that gets deleted
+        element->closeEasyChangeDialog();
+    }
+    for (auto force : Utilities::getAllElementsOfType<SingleForce *>(items())) {
+        if (force->getLoadCase() == loadCase) {
+            removeElement(force);
+        } else if (force->getLoadCase() > loadCase) {
+            force->setLoadCase(force->getLoadCase() - 1); // the indices of the following load-cases move down by one
+        }
+    }
+    loadCases.removeAt(loadCase);
+    for (LoadCombination &combination : loadCombinations) {
+        if (loadCase < combination.factors.size()) {
+            combination.factors.removeAt(loadCase);
+        }
+    }
+    if (activeLoadCase >= loadCase && activeLoadCase > 0) {
+        activeLoadCase--;
+    }
+    updateLoadCaseVisibility();
+    requestCalculation();
+}
+
+void GraphicsScene::setActiveLoadCase(int loadCase)
+{
+    if (loadCase < 0 || loadCase >= loadCases.size() || loadCase == activeLoadCase) {
+        return;
+    }
+    if (auto element = getEasyChangeDialogElement()) { // the dialog could belong to a force that gets hidden
+        element->closeEasyChangeDialog();
+    }
+    activeLoadCase = loadCase;
+    updateLoadCaseVisibility();
+    showOtherResult();
+}
+
+void GraphicsScene::setLoadCombinations(const QVector<LoadCombination> &combinations)
+{
+    loadCombinations = combinations;
+    for (LoadCombination &combination : loadCombinations) {
+        combination.factors.resize(loadCases.size());
+    }
+    if (shownResult >= loadCombinations.size() || (shownResult == showEnvelope && loadCombinations.isEmpty())) {
+        shownResult = showActiveLoadCase;
+    }
+    requestCalculation(); // the envelope is part of the solution, the stiffness did not change, so the cached factorization gets reused
+}
+
+void GraphicsScene::setShownResult(int result)
+{
+    if (result < showEnvelope || result >= loadCombinations.size() || (result == showEnvelope && loadCombinations.isEmpty()) || result == shownResult) {
+        return;
+    }
+    shownResult = result;
+    showOtherResult();
+}
+
+void GraphicsScene::showOtherResult()
+{
+    if (bucklingModes > 0) {
+        requestCalculation(); // the loads are solved from the cached factorization again, the buckling analysis needs the normal-forces of the other result
+    } else {
+        calculationService->reapplySolution(); // all load-cases were solved together, the combinations are evaluated from their stored results
+    }
+}
+
+void GraphicsScene::updateLoadCaseVisibility()
+{
+    for (auto force : Utilities::getAllElementsOfType<SingleForce *>(items())) {
+        force->setVisible(force->getLoadCase() == activeLoadCase);
+    }
+}
+
 template<typename T>
-void GraphicsScene::setupElementFromJson(const QJsonValue &jsonElement, QList<QPair<QString, TrussElement *>> &memoryMap)
+void GraphicsScene::setupElementFromJson(const QJsonObject &jsonElement, QList<QPair<QString, TrussElement *>> &memoryMap)
 {
     auto trussElement = new T(); // default construct the element (the scene takes ownership of the trussElement later)
-    trussElement->loadFromJson(jsonElement.toObject()); // alter values of element
-    memoryMap.append(QPair<QString, TrussElement *>(jsonElement.toObject().value(JsonKeys::thisItem).toString(), trussElement)); // append element to map (oldAddress, newAddress)
+    trussElement->loadFromJson(jsonElement); // alter values of element
+    memoryMap.append(QPair<QString, TrussElement *>(jsonElement.value(JsonKeys::thisItem).toString(), trussElement)); // append element to map (oldAddress, newAddress)
     addItem(trussElement); // pass the ownership of the trussElement to the scene
 }
 
@@ -389,16 +659,27 @@ void GraphicsScene::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
     QGraphicsScene::mouseMoveEvent(event); // pass event to parent to handle hovering of the nodes
     // recalculate the system every time the mouse moves when not in adding-mode
     if (nodeAdder == nullptr && rodAdder == nullptr && forceAdder == nullptr && bearingAdder == nullptr && dimensionAdder == nullptr) {
-        static_cast<MainWindow *>(parent())->setStatusBarMessage(Calculator::calculate(this));
-        if (static_cast<MainWindow *>(parent())->getColorRods() || static_cast<MainWindow *>(parent())->getMarkZeroLoadingRods()) {
-            update(itemsBoundingRect()); // redraw whole scene after recalculating the model to properly color the rods
-        }
+        requestCalculation();
     }
     if (clickInEmptySceneSpace == true) {
         // todo: implement mouse-moving the scene
     }
 }
 
+void GraphicsScene::requestCalculation()
+{
+    auto status = calculationService->requestCalculation(); // the model is solved in the background, showCalculationResults() gets called when it is done
+    if (status != "") { // the model could not be extracted, so no calculation is running
+        showCalculationResults(status);
+    }
+}
+
+void GraphicsScene::showCalculationResults(const QString &status)
+{
+    static_cast<MainWindow *>(parent())->setStatusBarMessage(status);
+    update(itemsBoundingRect()); // redraw whole scene after recalculating the model to properly color and deform the rods
+}
+
 void GraphicsScene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 {
     clickInEmptySceneSpace = false;
@@ -1,7 +1,10 @@
 #ifndef GRAPHICSSCENE_H
 #define GRAPHICSSCENE_H
 
+#include "solver/trussmodel.h"
+
 #include <QGraphicsScene>
+#include <QStringList>
 
 #include <memory>
 
@@ -14,6 +17,12 @@ class ForceAdder;
 class DimensionAdder;
 class LabelAdder;
 class MainWindow;
+class CalculationService;
+class SpatialIndex;
+enum class SolverBackend : int;
+enum class DofOrdering : int;
+enum class AnalysisType : int;
+enum class MassMatrix : int;
 
 class GraphicsScene final : public QGraphicsScene
 {
@@ -42,6 +51,7 @@ public:
 
     void addNode(bool checked);
     void addRod(bool checked);
+    void addRope(bool checked); // like addRod(), but the new rods are ropes
     void addBearing(bool checked);
     void addForce(bool checked);
     void addDimension(bool checked);
@@ -68,9 +78,68 @@ public:
     void setDisplacementCalculationStep(double s) { displacementCalculationStep = s; }
     double getDisplacementCalculationStep() const { return displacementCalculationStep; }
 
+    void setSparseAssemblyThreshold(int t) { sparseAssemblyThreshold = t; }
+    int getSparseAssemblyThreshold() const { return sparseAssemblyThreshold; }
+
+    void setSolverBackend(SolverBackend backend) { solverBackend = backend; }
+    SolverBackend getSolverBackend() const { return solverBackend; }
+
+    void setDofOrdering(DofOrdering ordering) { dofOrdering = ordering; }
+    DofOrdering getDofOrdering() const { return dofOrdering; }
+
+    void setMaxLowRankUpdates(int u) { maxLowRankUpdates = u; }
+    int getMaxLowRankUpdates() const { return maxLowRankUpdates; }
+
+    void setThreadCount(int t) { threadCount = t; }
+    int getThreadCount() const { return threadCount; }
+
+    void setAnalysisType(AnalysisType type); // saved with the project, solves the system again if the type changed
+    AnalysisType getAnalysisType() const { return analysisType; }
+
+    void setLoadSteps(int steps); // saved with the project, solves the system again if the value changed
+    int getLoadSteps() const { return loadSteps; }
+
+    // the buckling analysis uses the normal-forces of the shown result (the active load-case for the envelope), see Calculator::SolverSettings::bucklingColumn
+    void setBucklingModes(int modes); // saved with the project, number of buckling load-factors, 0: no buckling analysis
+    int getBucklingModes() const { return bucklingModes; }
+    int getBucklingColumn() const;
+
+    void setNaturalModes(int modes); // saved with the project, number of natural frequencies, 0: no modal analysis
+    int getNaturalModes() const { return naturalModes; }
+    void setMassMatrix(MassMatrix type); // saved with the project
+    MassMatrix getMassMatrix() const { return massMatrix; }
+
+    // the mode-shapes of a solution are its buckling modes followed by its natural modes
+    static const int showDeformation = -1; // value of the shown mode-shape that is no index of a mode
+    void setShownModeShape(int mode); // the rods get drawn deformed like the mode-shape instead of the displacements of the shown result
+    int getShownModeShape() const { return shownModeShape; }
+
+    SpatialIndex *getSpatialIndex() const { return spatialIndex.get(); } // returns weak ptr
+
+    // the forces of all load-cases are solved together, only the forces and results of the active load-case are shown
+    QStringList getLoadCases() const { return loadCases; }
+    int addLoadCase(const QString &name); // returns the index of the new load-case
+    void renameLoadCase(int loadCase, const QString &name);
+    void removeLoadCase(int loadCase); // deletes the forces of the load-case, the last remaining load-case can not be removed
+    void setActiveLoadCase(int loadCase); // the results are taken from the last solution, the system is not solved again
+    int getActiveLoadCase() const { return activeLoadCase; }
+
+    // the load-combinations are evaluated from the results of the load-cases, every combination has one factor per load-case
+    QVector<LoadCombination> getLoadCombinations() const { return loadCombinations; }
+    void setLoadCombinations(const QVector<LoadCombination> &combinations);
+    static const int showActiveLoadCase = -1; // values of the shown result that are no index of a load-combination
+    static const int showEnvelope = -2;
+    void setShownResult(int result); // showActiveLoadCase, the index of a load-combination or showEnvelope
+    int getShownResult() const { return shownResult; }
+
 private:
+    void requestCalculation(); // solves the system in the background, showCalculationResults() gets called when it is done
+    void showCalculationResults(const QString &status);
+    void updateLoadCaseVisibility(); // hides the forces that do not belong to the active load-case
+    void showOtherResult(); // applies the results of another load-case or combination, the buckling analysis has to be solved again for its normal-forces
+
     template<typename T>
-    void setupElementFromJson(const QJsonValue &jsonElement, QList<QPair<QString, TrussElement *>> &memoryMap);
+    void setupElementFromJson(const QJsonObject &jsonElement, QList<QPair<QString, TrussElement *>> &memoryMap);
 
     std::unique_ptr<NodeAdder> nodeAdder;
     std::unique_ptr<RodAdder> rodAdder;
@@ -83,6 +152,23 @@ private:
     bool clickInEmptySceneSpace; // true if the user clicks in empty scene space
     double maxDisplacementDistance; // distance that the max displacement is drawn away from the unloaded rod
     double displacementCalculationStep; // indicates how fine the deformed system is drawn
+    int sparseAssemblyThreshold; // systems with more dofs than this value get assembled into a sparse GSM
+    SolverBackend solverBackend; // backend used to solve K_aa * U_a = F_a - K_ab * U_b
+    DofOrdering dofOrdering; // order in which the nodes get their dofs
+    int maxLowRankUpdates; // moving nodes updates the cached factorization this many times before K gets factorized again
+    int threadCount; // threads that compute the ESMs and assemble the sparse GSM, 0: one per core
+    AnalysisType analysisType; // frame (3 dofs per node), truss (2 dofs per node) or automatically detected
+    int loadSteps; // 0: linear analysis, > 0: second-order analysis with this many load-steps
+    int bucklingModes; // 0: no buckling analysis
+    int naturalModes; // 0: no modal analysis
+    MassMatrix massMatrix; // lumped or consistent mass-matrices of the rods in the modal analysis
+    std::unique_ptr<CalculationService> calculationService; // recalculates the model on a worker-thread
+    std::unique_ptr<SpatialIndex> spatialIndex; // used for hit-testing, the elements keep it up to date themselves
+    QStringList loadCases; // names of the load-cases, the index is stored in the forces
+    int activeLoadCase;
+    QVector<LoadCombination> loadCombinations;
+    int shownResult; // whose results are applied to the elements, see setShownResult()
+    int shownModeShape; // showDeformation or the index of a mode-shape
 
     // QGraphicsScene interface
 protected:
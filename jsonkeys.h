@@ -33,6 +33,21 @@ namespace JsonKeys { // there is no .cpp-file of this .h-file because it only de
     const QString force = "rodForce";
     const QString orientation = "orientation";
     const QString baselinePos = "baselinePos";
+    const QString scaleValue = "scaleValue";
+    const QString youngsModulus = "youngsModulus";
+    const QString crossSectionArea = "crossSectionArea";
+    const QString areaMomentOfInertia = "areaMomentOfInertia";
+    const QString density = "density";
+    const QString loadCases = "loadCases";
+    const QString loadCase = "loadCase";
+    const QString loadCombinations = "loadCombinations";
+    const QString name = "name";
+    const QString factors = "factors";
+    const QString analysisType = "analysisType";
+    const QString loadSteps = "loadSteps";
+    const QString bucklingModes = "bucklingModes";
+    const QString naturalModes = "naturalModes";
+    const QString massMatrix = "massMatrix";
 } // end namespace JsonKeys
 
 #endif // JSONKEYS_H
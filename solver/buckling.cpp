@@ -0,0 +1,130 @@
+#include "solver/buckling.h"
+
+#include "solver/elementtraits.h"
+#include "solver/factorizationcache.h"
+#include "solver/lanczos.h"
+#include "solver/linearsolver.h"
+#include "solver/parallelrange.h"
+#include "solver/partitionedsystem.h"
+
+#include <cmath>
+#include <memory>
+
+namespace
+{
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, 4, 6> TransverseMatrix;
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, 4, 4> LocalMatrix;
+
+    template<typename Traits>
+    void determineTransverseESM(const TrussModel &model, int e, double N, Calculator::ElementMatrix &k_g)
+    {
+        // only the transverse displacements w (perpendicular to the chord, counterclockwise in the right-handed frame with Y = - y like in solver/nonlinear.cpp)
+        // and the rotations contribute, the local dofs are w1, (r1,) w2, (r2)
+        double l = model.getRodLength(e);
+        double angle = model.getRodAngle(e);
+        double c = cos(angle);
+        double s = sin(angle);
+        int localCount = Traits::hasBending ? 4 : 2;
+        TransverseMatrix B = TransverseMatrix::Zero(localCount, Traits::dofCount);
+        for (int n = 0; n < 2; n++) {
+            int w = Traits::hasBending ? 2 * n : n;
+            B(w, Traits::x(n)) = - s; // w = - s * X + c * Y with X = x and Y = - y
+            B(w, Traits::y(n)) = - c;
+            if (Traits::hasBending) {
+                B(w + 1, Traits::m(n)) = 1;
+            }
+        }
+        LocalMatrix k_local(localCount, localCount);
+        if (Traits::hasBending) { // consistent with the cubic shape-functions of the beam, a single beam per column is then accurate to about 1 %
+            k_local << 36, 3 * l, -36, 3 * l,
+                       3 * l, 4 * l * l, -3 * l, - l * l,
+                       -36, -3 * l, 36, -3 * l,
+                       3 * l, - l * l, -3 * l, 4 * l * l;
+            k_local *= N / (30 * l);
+        } else { // the chord-rotation of a straight bar, like N / l * z * z^T of the corotational bar
+            k_local << 1, -1,
+                       -1, 1;
+            k_local *= N / l;
+        }
+        k_g = B.transpose() * k_local * B;
+    }
+} // end anonymous namespace
+
+void Buckling::determineGeometricESM(const TrussModel &model, RodType type, int e, double N, Calculator::ElementMatrix &k_g)
+{
+    visitRodType(type, [&](auto traits) {
+        determineTransverseESM<decltype(traits)>(model, e, N, k_g);
+    });
+}
+
+QString Buckling::solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, const Eigen::VectorXd &innerForces,
+                        const QVector<int> &slackRopes, int modeCount, Eigen::VectorXd &loadFactors, Eigen::MatrixXd &modes, int &iterations)
+{
+    loadFactors = Eigen::VectorXd();
+    modes = Eigen::MatrixXd();
+    iterations = 0;
+    const PartitionedSystem &system = factorization.system;
+    const QVector<int> &freeDofs = system.getFreeDofs();
+    int dofCount = factorization.dofCount;
+    int rodCount = model.getRodCount();
+    int n = freeDofs.size();
+    if (modeCount <= 0 || n == 0) {
+        return "";
+    }
+    if (factorization.solver == nullptr || factorization.solver->isSingular()) {
+        return "the buckling analysis needs a stable system, the stiffness-matrix is singular";
+    }
+
+    // K_G is always assembled sparse, it is only needed for matrix-vector-products (a slack rope has no normal-force, therefore no geometric stiffness)
+    QVector<Calculator::ElementMatrix> k_gs(rodCount);
+    Calculator::ElementMatrix *k_g = k_gs.data(); // detach here and not on the threads
+    int rangeCount = Parallel::determineRangeCount(rodCount, Parallel::determineThreadCount(settings.threadCount), Parallel::minRodsPerThread);
+    Parallel::forEachRange(rodCount, rangeCount, [&](int, int begin, int end) {
+        for (int e = begin; e < end; e++) {
+            determineGeometricESM(model, factorization.rodTypes.at(e), e, innerForces(e), k_g[e]);
+        }
+    });
+    Eigen::SparseMatrix<double> K_G, K_G_aa, K_G_ab, K_G_ba, K_G_bb;
+    auto status = Calculator::assembleSparseGSM(dofCount, rodCount, factorization.coincidenceTable, k_gs, settings.threadCount, K_G);
+    if (status != "") {
+        return status;
+    }
+    system.extractBlocks(K_G, K_G_aa, K_G_ab, K_G_ba, K_G_bb);
+
+    // the slack ropes of the result are not part of its K, the cached factorization contains them, so K_aa gets factorized once more without them
+    Eigen::SparseMatrix<double> K_aa = factorization.K_aa;
+    std::unique_ptr<LinearSolver> slackSolver;
+    if (!slackRopes.isEmpty()) {
+        QVector<Calculator::ElementMatrix> k_es(rodCount); // empty ESMs contribute nothing to the assembly
+        for (int e : slackRopes) {
+            k_es[e] = factorization.elementMatrices.at(e);
+        }
+        Eigen::SparseMatrix<double> K_slack, K_slack_aa, K_slack_ab, K_slack_ba, K_slack_bb;
+        status = Calculator::assembleSparseGSM(dofCount, rodCount, factorization.coincidenceTable, k_es, settings.threadCount, K_slack);
+        if (status != "") {
+            return status;
+        }
+        system.extractBlocks(K_slack, K_slack_aa, K_slack_ab, K_slack_ba, K_slack_bb);
+        K_aa = K_aa - K_slack_aa;
+        slackSolver.reset(new LinearSolver(settings.solverBackend, settings.dofOrdering != DofOrdering::Natural));
+        slackSolver->factorize(K_aa);
+        if (slackSolver->isSingular()) {
+            return "the buckling analysis needs a stable system, the system is kinematic without the slack ropes";
+        }
+    }
+    auto applyInverse = [&](const Eigen::VectorXd &b) -> Eigen::VectorXd { // K_aa^-1 * b
+        iterations++;
+        return slackSolver != nullptr ? Eigen::VectorXd(slackSolver->solve(b)) : Eigen::VectorXd(factorization.solve(b));
+    };
+
+    // (K + eta * K_G) * phi = 0 is - K_G * phi = 1 / eta * K * phi, the smallest positive load-factors are the largest eigenvalues of K^-1 * (- K_G)
+    Eigen::SparseMatrix<double> B_aa = - K_G_aa;
+    Eigen::VectorXd mu;
+    Eigen::MatrixXd phi_a;
+    if (!Lanczos::solve(K_aa, B_aa, applyInverse, modeCount, mu, phi_a)) {
+        return "the buckling analysis did not converge";
+    }
+    loadFactors = mu.cwiseInverse();
+    Lanczos::scatterModes(factorization, phi_a, modes);
+    return "";
+}
@@ -0,0 +1,26 @@
+#ifndef BUCKLING_H
+#define BUCKLING_H
+
+#include "calculator.h"
+
+#include <QString>
+#include <QVector>
+
+class FactorizationCache;
+
+// linear buckling: (K + eta * K_G) * phi = 0, K_G is the geometric stiffness-matrix of the normal-forces N of one result, eta the load-factor at which the system gets unstable
+// this is - K_G * phi = 1 / eta * K * phi, the smallest positive eta are the largest eigenvalues of K^-1 * (- K_G), see solver/lanczos.h
+// the shift-invert iteration only needs the factorization of K_aa that the linear solve() already has (including its low-rank correction) and sparse products with K_G
+namespace Buckling
+{
+    // innerForces: normal-forces of the rods (one column of Solution::innerForces), slackRopes: ropes that are not part of K (then K_aa gets factorized without them)
+    // loadFactors gets the smallest positive load-factors in ascending order (fewer than modeCount if the system has fewer compressed modes, none without compression)
+    // modes gets one mode-shape per load-factor (one entry per dof, 0 at the prescribed dofs, the largest displacement is 1)
+    QString solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, const Eigen::VectorXd &innerForces,
+                  const QVector<int> &slackRopes, int modeCount, Eigen::VectorXd &loadFactors, Eigen::MatrixXd &modes, int &iterations);
+
+    // geometric ESM of the rod e in global coords (in the order of its coincidence-table) for the normal-force N, the consistent matrix of the cubic beam for beams
+    void determineGeometricESM(const TrussModel &model, RodType type, int e, double N, Calculator::ElementMatrix &k_g);
+}
+
+#endif // BUCKLING_H
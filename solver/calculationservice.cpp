@@ -0,0 +1,170 @@
+#include "calculationservice.h"
+
+#include "graphicsscene.h"
+#include "elements/rod.h"
+
+#include <QMutexLocker>
+
+CalculationService::CalculationService(GraphicsScene *scene) :
+    QThread(),
+    scene(scene),
+    generation(0),
+    cancelledGeneration(0),
+    stopRequested(false),
+    hasRequest(false),
+    requestGeneration(0),
+    hasSolution(false),
+    solutionGeneration(0)
+{
+    // solutionAvailable is emitted in the worker-thread but this object lives in the gui-thread, therefore the connection is queued and publishSolution() runs in the gui-thread
+    connect(this, &CalculationService::solutionAvailable, this, &CalculationService::publishSolution);
+    start(QThread::LowPriority);
+}
+
+CalculationService::~CalculationService()
+{
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+        requestAvailable.wakeOne();
+    }
+    wait();
+}
+
+QString CalculationService::requestCalculation()
+{
+    QList<Rod *> rods;
+    TrussModel model;
+    auto status = Calculator::extractModel(scene, model, rods);
+    if (status != "") {
+        cancel(); // the model is invalid, therefore no solution of an older request must be drawn anymore
+        return status;
+    }
+    generation++;
+    QList<QPointer<Rod>> rodPtrs;
+    rodPtrs.reserve(rods.size());
+    for (auto rod : rods) {
+        rodPtrs.append(rod);
+    }
+    requestedRods.insert(generation, rodPtrs);
+    QMutexLocker locker(&mutex);
+    if (hasRequest) { // the worker did not start the previous request yet, so it is replaced by this one
+        requestedRods.remove(requestGeneration);
+    }
+    hasRequest = true;
+    requestGeneration = generation;
+    requestedModel = std::move(model);
+    requestedSettings = Calculator::getSolverSettings(scene);
+    requestAvailable.wakeOne();
+    return "";
+}
+
+void CalculationService::cancel()
+{
+    cancelledGeneration = generation;
+    requestedRods.clear();
+    publishedRods.clear();
+    publishedSolution = Calculator::Solution();
+    QMutexLocker locker(&mutex);
+    hasRequest = false;
+}
+
+void CalculationService::reapplySolution()
+{
+    QList<Rod *> rods;
+    rods.reserve(publishedRods.size());
+    for (auto rod : publishedRods) {
+        if (rod.isNull()) { // a rod was deleted meanwhile, the solution is obsolete
+            rods.clear();
+            break;
+        }
+        rods.append(rod.data());
+    }
+    if (rods.isEmpty()) {
+        auto status = requestCalculation();
+        if (status != "") {
+            emit calculationFinished(status);
+        }
+        return;
+    }
+    emit calculationFinished(Calculator::applySolution(scene, rods, publishedSolution));
+}
+
+void CalculationService::run()
+{
+    forever {
+        quint64 currentGeneration;
+        TrussModel model;
+        Calculator::SolverSettings settings;
+        {
+            QMutexLocker locker(&mutex);
+            while (!hasRequest && !stopRequested) {
+                requestAvailable.wait(&mutex);
+            }
+            if (stopRequested) {
+                return;
+            }
+            hasRequest = false;
+            currentGeneration = requestGeneration;
+            model = std::move(requestedModel);
+            settings = requestedSettings;
+        }
+        Calculator::Solution currentSolution;
+        auto status = Calculator::solve(model, settings, currentSolution, &factorizationCache);
+        {
+            QMutexLocker locker(&mutex);
+            hasSolution = true; // a solution that was not published yet gets overwritten by the newer one
+            solutionGeneration = currentGeneration;
+            solutionStatus = status;
+            solution = std::move(currentSolution);
+        }
+        emit solutionAvailable();
+    }
+}
+
+void CalculationService::publishSolution()
+{
+    quint64 currentGeneration;
+    QString status;
+    Calculator::Solution currentSolution;
+    {
+        QMutexLocker locker(&mutex);
+        if (!hasSolution) { // already published together with an earlier signal
+            return;
+        }
+        hasSolution = false;
+        currentGeneration = solutionGeneration;
+        status = solutionStatus;
+        currentSolution = std::move(solution);
+    }
+    if (currentGeneration <= cancelledGeneration) {
+        return;
+    }
+    // the rods of this and all older requests are not needed anymore
+    auto rodPtrs = requestedRods.value(currentGeneration);
+    for (auto it = requestedRods.begin(); it != requestedRods.end();) {
+        if (it.key() <= currentGeneration) {
+            it = requestedRods.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    QList<Rod *> rods;
+    rods.reserve(rodPtrs.size());
+    for (auto rod : rodPtrs) {
+        if (rod.isNull()) { // a rod was deleted after the request, the solution is obsolete
+            return;
+        }
+        rods.append(rod.data());
+    }
+    if (status != "") {
+        Calculator::resetResults(scene);
+        publishedRods.clear();
+        publishedSolution = Calculator::Solution();
+    } else {
+        status = Calculator::applySolution(scene, rods, currentSolution);
+        publishedRods = rodPtrs;
+        publishedSolution = std::move(currentSolution);
+    }
+    emit calculationFinished(status);
+}
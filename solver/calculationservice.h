@@ -0,0 +1,70 @@
+#ifndef CALCULATIONSERVICE_H
+#define CALCULATIONSERVICE_H
+
+#include "calculator.h"
+#include "solver/factorizationcache.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QPointer>
+
+class GraphicsScene;
+class Rod;
+
+// solves the system on a worker-thread so that the gui does not block while the user drags nodes around
+// the gui-thread extracts a snapshot of the model (Calculator::extractModel()), the worker-thread solves it (Calculator::solve()) and the solution gets applied
+// to the items in the gui-thread again (Calculator::applySolution()); if new requests arrive while the worker is busy, only the newest one is kept, the older ones are dropped
+class CalculationService final : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit CalculationService(GraphicsScene *scene);
+    ~CalculationService() override; // a running calculation gets finished before the worker-thread stops, not designed to be inherited
+    // disable copying/moving, the worker-thread and the scene are bound to this object
+    CalculationService(const CalculationService &) = delete;
+    CalculationService(CalculationService &&) = delete;
+    CalculationService &operator =(const CalculationService &) = delete;
+    CalculationService &operator =(CalculationService &&) = delete;
+
+    QString requestCalculation(); // has to be called in the gui-thread, returns an error-message if the model could not be extracted, "" otherwise
+    void cancel(); // drops the waiting request and discards the solution of the running one
+    void reapplySolution(); // applies the last published solution again (e.g. to show another load-case), requests a new calculation if there is none
+
+signals:
+    void calculationFinished(const QString &status); // emitted in the gui-thread after the solution was applied to the items
+    void solutionAvailable(); // emitted in the worker-thread, for internal use only
+
+private:
+    void run() override; // worker-thread loop
+    void publishSolution(); // gui-thread
+
+    GraphicsScene *scene;
+
+    // only accessed in the gui-thread
+    quint64 generation; // increased by every request, used to match a solution to the rods it was extracted from
+    quint64 cancelledGeneration; // solutions of this and older generations get discarded
+    QHash<quint64, QList<QPointer<Rod>>> requestedRods; // the rods of every request that has not been published yet, the ptrs get null if a rod is deleted meanwhile
+    QList<QPointer<Rod>> publishedRods; // the rods and the solution of the last published request, kept to apply another load-case without solving again
+    Calculator::Solution publishedSolution;
+
+    // only accessed in the worker-thread
+    FactorizationCache factorizationCache; // load-only changes (e.g. editing a force) skip the assembly and factorization of K
+
+    // shared between the threads, guarded by mutex
+    QMutex mutex;
+    QWaitCondition requestAvailable;
+    bool stopRequested;
+    bool hasRequest;
+    quint64 requestGeneration;
+    TrussModel requestedModel;
+    Calculator::SolverSettings requestedSettings;
+    bool hasSolution;
+    quint64 solutionGeneration;
+    QString solutionStatus;
+    Calculator::Solution solution;
+};
+
+#endif // CALCULATIONSERVICE_H
@@ -0,0 +1,767 @@
+#include "calculator.h"
+
+#include "solver/buckling.h"
+#include "solver/elementkernel.h"
+#include "solver/elementtraits.h"
+#include "solver/factorizationcache.h"
+#include "solver/linearsolver.h"
+#include "solver/loadcombination.h"
+#include "solver/modal.h"
+#include "solver/nonlinear.h"
+#include "solver/parallelrange.h"
+#include "solver/partitionedsystem.h"
+#include "solver/tensiononly.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // beyond this many corrected dofs the forward/back-substitutions for Z cost about as much as factorizing K_aa again
+    const int maxCorrectionRank = 96;
+    // relative residual of K_aa * U_a = F_a - K_ab * U_b above which the low-rank correction is not trusted anymore
+    const double maxRelativeResidual = 1e-8;
+    // columns with more unmerged entries than this get sorted with std::stable_sort instead of an insertion-sort
+    const int maxInsertionSortLength = 32;
+
+    void storeBlock(const Eigen::MatrixXd &block, Eigen::SparseMatrix<double> &stored)
+    {
+        stored = block.sparseView();
+    }
+
+    void storeBlock(const Eigen::SparseMatrix<double> &block, Eigen::SparseMatrix<double> &stored)
+    {
+        stored = block;
+    }
+
+    template<typename Matrix>
+    QString factorizePartitionedSystem(const Eigen::VectorXb &F_k, const Eigen::VectorXb &U_k, const Matrix &K, FactorizationCache &factorization)
+    {
+        auto status = factorization.system.partition(F_k, U_k); // sort knowns/unknowns (index a: F known, U unknown; index b: U known, F unknown)
+        if (status != "") {
+            return status;
+        }
+        Matrix K_aa, K_ab, K_ba, K_bb; // K_aa: known Fs and unknown Us, K_ab: known Fs and known Us, K_ba: unknown Fs and unknown Us, K_bb: unknown Fs and known Us
+        factorization.system.extractBlocks(K, K_aa, K_ab, K_ba, K_bb);
+        // K_aa is symmetric and positive definite unless the system is kinematic, in which case the solver falls back to the pseudo-inverse
+        factorization.solver->factorize(K_aa);
+        storeBlock(K_aa, factorization.K_aa);
+        storeBlock(K_ab, factorization.K_ab);
+        storeBlock(K_ba, factorization.K_ba);
+        storeBlock(K_bb, factorization.K_bb);
+        return "";
+    }
+
+    template<typename Traits>
+    void numberRodDofs(const TrussModel &model, int e, const QVector<int> &nodeFirstDof, QVector<int> &usedRotationDofs, QVector<int> &dofGlobal)
+    {
+        dofGlobal.resize(Traits::dofCount);
+        for (int n = 0; n < 2; n++) {
+            int node = n == 0 ? model.rodNode1.at(e) : model.rodNode2.at(e);
+            int first = nodeFirstDof.at(node);
+            dofGlobal[Traits::y(n)] = first;
+            dofGlobal[Traits::x(n)] = first + 1;
+            if (Traits::hasBending) {
+                if (model.nodeType.at(node) == NodeType::GerberJoint) {
+                    dofGlobal[Traits::m(n)] = first + 2 + usedRotationDofs[node]++; // at a gerber-joint every connected beam gets its own rotation-dof
+                } else {
+                    dofGlobal[Traits::m(n)] = first + 2;
+                }
+            }
+        }
+    }
+} // end anonymous namespace
+
+QString Calculator::solve(const TrussModel &model, const SolverSettings &settings, Solution &solution, FactorizationCache *cache)
+{
+    // everything that only depends on the stiffness is taken from the cache if possible, then only the loads have to be applied and substituted
+    FactorizationCache temporaryFactorization; // used if the caller does not keep a cache
+    FactorizationCache &factorization = cache != nullptr ? *cache : temporaryFactorization;
+    AnalysisType analysisType = determineAnalysisType(model, settings);
+    if (analysisType == AnalysisType::Truss && model.nodeMz.count(0.0) != model.nodeMz.size()) {
+        return "moments can not be applied in a truss-analysis, the nodes have no rotation-dofs";
+    }
+    solution.reusedFactorization = factorization.isValidFor(model, settings);
+    if (!solution.reusedFactorization) {
+        // if e.g. only a node was moved, the factorization is kept and corrected for the changed ESMs, otherwise K gets assembled and factorized again
+        bool updated = factorization.canUpdateTo(model, settings) && factorization.updateCount < settings.maxLowRankUpdates
+                && updateFactorization(model, settings, factorization) == "";
+        if (!updated) {
+            auto status = factorizeSystem(model, settings, factorization);
+            if (status != "") {
+                factorization.clear(); // do not keep a half-filled cache
+                return status;
+            }
+        }
+        if (cache != nullptr) {
+            factorization.setKey(model, settings);
+        }
+    }
+    solution.correctionRank = factorization.correctionDofs.size();
+    solution.usedAnalysisType = factorization.analysisType;
+    int dofCount = factorization.dofCount;
+    solution.dofCount = dofCount;
+    solution.nodeFirstDof = factorization.nodeFirstDof;
+    solution.nodeDofCount = factorization.nodeDofCount;
+    solution.rodNode1 = model.rodNode1;
+    solution.rodNode2 = model.rodNode2;
+    solution.rodTypes = factorization.rodTypes;
+    solution.coincidenceTable = factorization.coincidenceTable;
+    solution.T_es = factorization.T_es;
+    solution.usedOrdering = factorization.usedOrdering;
+    solution.naturalMetrics = factorization.naturalMetrics;
+    solution.metrics = factorization.metrics;
+    solution.usedThreadCount = factorization.usedThreadCount;
+    solution.esmMilliseconds = factorization.esmMilliseconds;
+    solution.assemblyMilliseconds = factorization.assemblyMilliseconds;
+
+    // apply the loads of all load-cases, the known-flags equal the ones the cached system was partitioned with because they only depend on the bearings
+    int loadCaseCount = model.getLoadCaseCount();
+    solution.F = Eigen::MatrixXd::Zero(dofCount, loadCaseCount); // initialize GLV with zeros (because the values are unknown, boundary conditions get applied below)
+    Eigen::VectorXb F_k = Eigen::VectorXb::Constant(dofCount, false); // initialize GLV-known-vector with false
+    solution.U = Eigen::MatrixXd::Zero(dofCount, loadCaseCount); // initialize GVV with zeros
+    Eigen::VectorXb U_k = Eigen::VectorXb::Constant(dofCount, false); // initialize GVV-known-vector with false
+    auto status = applyConstraints(model, solution.nodeFirstDof, solution.nodeDofCount, solution.F, F_k, solution.U, U_k);
+    if (status != "") {
+        return status;
+    }
+    // a slack rope or a second-order analysis makes the results nonlinear in the loads, then the load-combinations are solved as additional columns
+    Eigen::MatrixXd factors = Combination::determineFactors(model);
+    bool hasRopes = solution.rodTypes.contains(RodType::Rope);
+    bool secondOrder = settings.loadSteps > 0;
+    int combinationCount = hasRopes || secondOrder ? static_cast<int>(factors.cols()) : 0;
+    if (combinationCount > 0) {
+        Eigen::MatrixXd F(dofCount, loadCaseCount + combinationCount);
+        F << solution.F, solution.F * factors;
+        solution.F = F;
+        Eigen::MatrixXd U(dofCount, loadCaseCount + combinationCount);
+        U << solution.U, solution.U * factors;
+        solution.U = U;
+    }
+
+    // the system has the form K * U = F, which is split into known- and unknown-vectors:
+    //      (K_aa, K_ab,  *  (U_a,  =  (F_a,
+    //       K_ba, K_bb)      U_b)      F_b)
+    // firstly, solve first row for unknown Us with the factorization of K_aa, all load-cases are solved at once as the columns of one right-hand-side
+    const PartitionedSystem &system = factorization.system;
+    Eigen::MatrixXd F_a = system.getF_a(solution.F);
+    Eigen::MatrixXd U_b = system.getU_b(solution.U);
+    Eigen::MatrixXd F_a_reduced = F_a - factorization.K_ab * U_b;
+    Eigen::MatrixXd U_a = factorization.solve(F_a_reduced);
+    if (!factorization.correctionDofs.isEmpty()
+            && (factorization.K_aa * U_a - F_a_reduced).norm() > maxRelativeResidual * fmax(F_a_reduced.norm(), std::numeric_limits<double>::min())) {
+        // the correction drifted (S is ill-conditioned), therefore factorize K_aa again, the next solve() can not be corrected because the cache is invalid
+        factorization.clear();
+        return solve(model, settings, solution, cache);
+    }
+    // compressed ropes are removed and the columns are solved again, the ropes that were slack in the last solve() are the first guess
+    solution.slackRopes.clear();
+    solution.ropeIterations = 0;
+    if (hasRopes) {
+        solution.slackRopes = factorization.slackRopes;
+        status = TensionOnly::solve(model, factorization, F_a_reduced, U_b, U_a, solution.slackRopes, solution.ropeIterations);
+        if (status != "") {
+            return status;
+        }
+        factorization.slackRopes = solution.slackRopes;
+    }
+    // then solve second row for unknown Fs, using the Us calculated above
+    Eigen::MatrixXd F_b = factorization.K_ba * U_a + factorization.K_bb * U_b;
+    system.scatterResults(U_a, F_b, solution.U, solution.F); // put the calculated values for the unknowns back into the U and F matrix at the right position
+    solution.usedBackend = factorization.solver->getUsedBackend();
+
+    // determine the normal-forces of the rods from the displacements of their nodes
+    status = determineInnerForces(model, solution.rodTypes, solution.coincidenceTable, solution.U, solution.innerForces);
+    if (status != "") {
+        return status;
+    }
+    if (hasRopes) {
+        TensionOnly::removeSlackRopes(factorization, solution.slackRopes, solution.U, solution.F, solution.innerForces);
+    }
+    // the linear solution is the start of the second-order analysis, the converged displacements of the last solve() are tried first
+    solution.loadSteps.clear();
+    if (secondOrder) {
+        status = Nonlinear::solve(model, settings, factorization, F_a, U_b, factorization.secondOrderU, solution.U, solution.F, solution.innerForces, solution.slackRopes,
+                                  solution.loadSteps);
+        if (status != "") {
+            factorization.secondOrderU = Eigen::MatrixXd(); // a failed analysis is no good start for the next one
+            return status;
+        }
+        factorization.secondOrderU = solution.U;
+    }
+    // the buckling analysis takes the normal-forces of one result, a load-combination that was not solved as a column is combined from the load-cases
+    solution.bucklingFactors = Eigen::VectorXd();
+    solution.bucklingModes = Eigen::MatrixXd();
+    solution.bucklingIterations = 0;
+    solution.bucklingColumn = qBound(0, settings.bucklingColumn, loadCaseCount + static_cast<int>(factors.cols()) - 1);
+    if (settings.bucklingModes > 0) {
+        int column = solution.bucklingColumn;
+        Eigen::VectorXd N = column < solution.innerForces.cols() ? Eigen::VectorXd(solution.innerForces.col(column))
+                                                                  : Eigen::VectorXd(solution.innerForces.leftCols(loadCaseCount) * factors.col(column - loadCaseCount));
+        QVector<int> slackRopes = column < solution.slackRopes.size() ? solution.slackRopes.at(column) : QVector<int>();
+        status = Buckling::solve(model, settings, factorization, N, slackRopes, settings.bucklingModes, solution.bucklingFactors, solution.bucklingModes,
+                                 solution.bucklingIterations);
+        if (status != "") {
+            return status;
+        }
+    }
+    // the natural frequencies do not depend on the loads, while only they change (e.g. a load gets dragged) the modes of the last solve() are still valid
+    solution.modalIterations = 0;
+    solution.usedMassMatrix = settings.massMatrix;
+    if (settings.naturalModes <= 0) {
+        solution.naturalFrequencies = Eigen::VectorXd();
+        solution.naturalModes = Eigen::MatrixXd();
+    } else if (solution.reusedFactorization && factorization.modalModeCount == settings.naturalModes && factorization.modalMassMatrix == settings.massMatrix
+               && factorization.modalDensities == model.rodRho) {
+        solution.naturalFrequencies = factorization.naturalFrequencies;
+        solution.naturalModes = factorization.naturalModes;
+    } else {
+        factorization.modalModeCount = 0;
+        status = Modal::solve(model, settings, factorization, solution.naturalFrequencies, solution.naturalModes, solution.modalIterations);
+        if (status != "") {
+            return status;
+        }
+        factorization.modalDensities = model.rodRho;
+        factorization.modalMassMatrix = settings.massMatrix;
+        factorization.modalModeCount = settings.naturalModes;
+        factorization.naturalFrequencies = solution.naturalFrequencies;
+        factorization.naturalModes = solution.naturalModes;
+    }
+    solution.combinationU = solution.U.rightCols(combinationCount);
+    solution.combinationF = solution.F.rightCols(combinationCount);
+    solution.combinationInnerForces = solution.innerForces.rightCols(combinationCount);
+    if (combinationCount > 0) {
+        solution.U = Eigen::MatrixXd(solution.U.leftCols(loadCaseCount)); // copy, because the block would alias the matrix it gets assigned to
+        solution.F = Eigen::MatrixXd(solution.F.leftCols(loadCaseCount));
+        solution.innerForces = Eigen::MatrixXd(solution.innerForces.leftCols(loadCaseCount));
+    }
+
+    // without ropes and in a linear analysis the results are linear in the loads, then the load-combinations are linear combinations of the results of the load-cases
+    solution.envelope = Combination::determineEnvelope(solution, factors);
+    return "";
+}
+
+QString Calculator::factorizeSystem(const TrussModel &model, const SolverSettings &settings, FactorizationCache &factorization)
+{
+    // number dofs, firstly in the order of the nodes in the model (only to report the gain of the reordering), then in the requested order
+    int dofCount = 0;
+    int rodCount = model.getRodCount();
+    AnalysisType analysisType = determineAnalysisType(model, settings);
+    QVector<RodType> rodTypes = determineRodTypes(model, analysisType);
+    auto status = numberDofs(model, Ordering::determineNodeOrder(model, DofOrdering::Natural), rodTypes, dofCount, factorization.nodeFirstDof,
+                             factorization.nodeDofCount, factorization.coincidenceTable);
+    if (status != "") {
+        return status;
+    }
+    factorization.naturalMetrics = Ordering::determineMetrics(dofCount, factorization.coincidenceTable);
+    factorization.metrics = factorization.naturalMetrics;
+    factorization.usedOrdering = settings.dofOrdering;
+    if (settings.dofOrdering != DofOrdering::Natural) {
+        dofCount = 0;
+        status = numberDofs(model, Ordering::determineNodeOrder(model, settings.dofOrdering), rodTypes, dofCount, factorization.nodeFirstDof,
+                            factorization.nodeDofCount, factorization.coincidenceTable);
+        if (status != "") {
+            return status;
+        }
+        factorization.metrics = Ordering::determineMetrics(dofCount, factorization.coincidenceTable);
+    }
+    factorization.dofCount = dofCount;
+    factorization.analysisType = analysisType;
+    factorization.rodTypes = rodTypes;
+
+    // examine ESM
+    QVector<ElementMatrix> k_es(rodCount);
+    factorization.T_es.resize(rodCount);
+    factorization.usedThreadCount = Parallel::determineThreadCount(settings.threadCount);
+    QElapsedTimer phaseTimer; // the phases that run on several threads are timed, see Solution::esmMilliseconds
+    phaseTimer.start();
+    status = determineESM(model, rodTypes, settings.threadCount, k_es, factorization.T_es);
+    if (status != "") {
+        return status;
+    }
+    factorization.esmMilliseconds = phaseTimer.nsecsElapsed() / 1e6;
+    factorization.elementMatrices = k_es;
+    factorization.factorizedElementMatrices = k_es;
+    factorization.secondOrderU = Eigen::MatrixXd(); // the numbering may have changed
+    factorization.updateCount = 0;
+    factorization.correctionDofs.clear();
+
+    // assemble GSM, above the sparse-assembly-threshold only the non-zero entries are stored because the memory of the dense GSM grows with dofCount²
+    bool useSparseAssembly = dofCount > settings.sparseAssemblyThreshold;
+    Eigen::MatrixXd K; // dense GSM, only used if useSparseAssembly is false
+    Eigen::SparseMatrix<double> K_sparse; // sparse GSM, only used if useSparseAssembly is true
+    phaseTimer.restart();
+    if (useSparseAssembly) {
+        status = assembleSparseGSM(dofCount, rodCount, factorization.coincidenceTable, k_es, settings.threadCount, K_sparse);
+    } else {
+        K = Eigen::MatrixXd::Zero(dofCount, dofCount); // initialize GSM with zeros
+        status = assembleGSM(dofCount, rodCount, factorization.coincidenceTable, k_es, K);
+    }
+    if (status != "") {
+        return status;
+    }
+    factorization.assemblyMilliseconds = phaseTimer.nsecsElapsed() / 1e6;
+
+    // the known-flags of the constraints decide which dofs are free, the values (loads) are applied again in every solve()
+    Eigen::MatrixXd F = Eigen::MatrixXd::Zero(dofCount, model.getLoadCaseCount());
+    Eigen::VectorXb F_k = Eigen::VectorXb::Constant(dofCount, false);
+    Eigen::MatrixXd U = Eigen::MatrixXd::Zero(dofCount, model.getLoadCaseCount());
+    Eigen::VectorXb U_k = Eigen::VectorXb::Constant(dofCount, false);
+    status = applyConstraints(model, factorization.nodeFirstDof, factorization.nodeDofCount, F, F_k, U, U_k);
+    if (status != "") {
+        return status;
+    }
+
+    // partition and factorize K
+    factorization.solver.reset(new LinearSolver(settings.solverBackend, settings.dofOrdering != DofOrdering::Natural)); // keep the requested ordering, K_aa inherits it from K
+    if (useSparseAssembly) {
+        return factorizePartitionedSystem(F_k, U_k, K_sparse, factorization);
+    }
+    return factorizePartitionedSystem(F_k, U_k, K, factorization);
+}
+
+QString Calculator::updateFactorization(const TrussModel &model, const SolverSettings &settings, FactorizationCache &factorization)
+{
+    // only the ESMs of the rods at moved nodes (or with a changed E, A or I) differ, the numbering, the partition and the factorization of K_aa are kept
+    if (factorization.solver == nullptr || factorization.solver->isSingular()) { // the pseudo-inverse can not be corrected
+        return "the cached factorization can not be updated";
+    }
+    int rodCount = model.getRodCount();
+    QVector<ElementMatrix> k_es(rodCount);
+    QVector<Eigen::Matrix6d> T_es(rodCount);
+    auto status = determineESM(model, factorization.rodTypes, settings.threadCount, k_es, T_es);
+    if (status != "") {
+        return status;
+    }
+    const PartitionedSystem &system = factorization.system;
+    QVector<int> changedRods; // since the last solve(), their differences get added to the stored blocks
+    QVector<int> correctedRods; // since the factorization, their differences make up C
+    QVector<int> correctionIndex(system.getFreeDofs().size(), -1); // local index in U_a -> index in C, -1 if the dof is not corrected
+    QVector<int> correctionDofs;
+    for (int e = 0; e < rodCount; e++) {
+        if (k_es.at(e) != factorization.elementMatrices.at(e)) {
+            changedRods.append(e);
+        }
+        if (k_es.at(e) != factorization.factorizedElementMatrices.at(e)) {
+            correctedRods.append(e);
+            for (int dof : factorization.coincidenceTable.at(e)) {
+                if (system.isFree(dof) && correctionIndex.at(system.getLocalIndex(dof)) == -1) {
+                    correctionIndex[system.getLocalIndex(dof)] = correctionDofs.size();
+                    correctionDofs.append(system.getLocalIndex(dof));
+                }
+            }
+        }
+    }
+    int rank = correctionDofs.size();
+    if (rank > maxCorrectionRank) {
+        return "too many changed dofs for a low-rank update";
+    }
+
+    // K_aa (needed for the drift-check) and the other blocks always hold the current K
+    for (int e : changedRods) {
+        const QVector<int> &dof = factorization.coincidenceTable.at(e);
+        ElementMatrix delta = k_es.at(e) - factorization.elementMatrices.at(e);
+        for (int i = 0; i < dof.size(); i++) {
+            for (int j = 0; j < dof.size(); j++) {
+                int row = system.getLocalIndex(dof.at(i));
+                int col = system.getLocalIndex(dof.at(j));
+                if (system.isFree(dof.at(i))) {
+                    (system.isFree(dof.at(j)) ? factorization.K_aa : factorization.K_ab).coeffRef(row, col) += delta(i, j);
+                } else {
+                    (system.isFree(dof.at(j)) ? factorization.K_ba : factorization.K_bb).coeffRef(row, col) += delta(i, j);
+                }
+            }
+        }
+    }
+    factorization.K_aa.makeCompressed();
+    factorization.K_ab.makeCompressed();
+    factorization.K_ba.makeCompressed();
+    factorization.K_bb.makeCompressed();
+
+    // C = P^T * (K_aa - K_aa,factorized) * P, the entries of the other blocks are not part of the factorization
+    Eigen::MatrixXd C = Eigen::MatrixXd::Zero(rank, rank);
+    for (int e : correctedRods) {
+        const QVector<int> &dof = factorization.coincidenceTable.at(e);
+        ElementMatrix delta = k_es.at(e) - factorization.factorizedElementMatrices.at(e);
+        for (int i = 0; i < dof.size(); i++) {
+            for (int j = 0; j < dof.size(); j++) {
+                if (system.isFree(dof.at(i)) && system.isFree(dof.at(j))) {
+                    C(correctionIndex.at(system.getLocalIndex(dof.at(i))), correctionIndex.at(system.getLocalIndex(dof.at(j)))) += delta(i, j);
+                }
+            }
+        }
+    }
+    if (correctionDofs != factorization.correctionDofs) { // Z only depends on the selected dofs, therefore it stays the same while the same node is dragged around
+        Eigen::MatrixXd P = Eigen::MatrixXd::Zero(system.getFreeDofs().size(), rank);
+        for (int i = 0; i < rank; i++) {
+            P(correctionDofs.at(i), i) = 1;
+        }
+        factorization.correctionZ = factorization.solver->solve(P); // rank forward/back-substitutions instead of a new factorization
+    }
+    Eigen::MatrixXd Z_c(rank, rank); // P^T * Z
+    for (int i = 0; i < rank; i++) {
+        Z_c.row(i) = factorization.correctionZ.row(correctionDofs.at(i));
+    }
+    if (rank > 0) {
+        factorization.correctionS.compute(Eigen::MatrixXd::Identity(rank, rank) + C * Z_c);
+    }
+    factorization.correctionC = C;
+    factorization.correctionDofs = correctionDofs;
+    factorization.elementMatrices = k_es;
+    factorization.T_es = T_es;
+    factorization.updateCount++;
+    return "";
+}
+
+AnalysisType Calculator::determineAnalysisType(const TrussModel &model, const SolverSettings &settings)
+{
+    if (settings.analysisType != AnalysisType::Automatic) {
+        return settings.analysisType;
+    }
+    // a frame whose nodes are all gerber-joints has no bending-stiffness at the nodes, under pure node-loads its rods only get normal-forces
+    // nodes without beams do not matter, they get no rotation-dofs anyway (ropes are always hinged)
+    QVector<bool> hasBeams(model.getNodeCount(), false);
+    for (int e = 0; e < model.getRodCount(); e++) {
+        if (model.rodType.at(e) == RodType::Beam) {
+            hasBeams[model.rodNode1.at(e)] = true;
+            hasBeams[model.rodNode2.at(e)] = true;
+        }
+    }
+    for (int node = 0; node < model.getNodeCount(); node++) {
+        if (!hasBeams.at(node)) {
+            continue;
+        }
+        if (model.nodeType.at(node) != NodeType::GerberJoint
+                || (model.nodeHasBearing.at(node) && model.nodeBearingType.at(node) == BearingType::FixedClamping)) {
+            return AnalysisType::Frame;
+        }
+    }
+    if (model.nodeMz.count(0.0) != model.nodeMz.size()) {
+        return AnalysisType::Frame;
+    }
+    return AnalysisType::Truss;
+}
+
+QString Calculator::toString(AnalysisType analysisType)
+{
+    switch (analysisType) {
+    case AnalysisType::Automatic:
+        return "Automatisch";
+    case AnalysisType::Frame:
+        return "Rahmen (3 FHG/Knoten)";
+    default:
+        return "Fachwerk (2 FHG/Knoten)";
+    }
+}
+
+QString Calculator::toString(MassMatrix massMatrix)
+{
+    switch (massMatrix) {
+    case MassMatrix::Consistent:
+        return "Konsistent";
+    default:
+        return "Konzentriert (Knotenmassen)";
+    }
+}
+
+QVector<RodType> Calculator::determineRodTypes(const TrussModel &model, AnalysisType analysisType)
+{
+    if (analysisType != AnalysisType::Truss) {
+        return model.rodType; // implicitly shared, no copy
+    }
+    QVector<RodType> rodTypes = model.rodType;
+    std::replace(rodTypes.begin(), rodTypes.end(), RodType::Beam, RodType::Bar); // ropes stay ropes, they are tension-only in both analysis-types
+    return rodTypes;
+}
+
+QString Calculator::numberDofs(const TrussModel &model, const QVector<int> &nodeOrder, const QVector<RodType> &rodTypes, int &dofCount, QVector<int> &nodeFirstDof,
+                               QVector<int> &nodeDofCount, QVector<QVector<int>> &coincidenceTable)
+{
+    // this fct numbers the dofs node by node; it also applies transition-conditions by numbering corresponding dofs the same (boundary-conditions are applied later in another fct)
+    // every node gets one block of dofs: y, x (shared by all connected rods), then one rotation-dof at a weld or one rotation-dof per connected beam at a gerber-joint
+    // nodes without rods get an empty block, nodes without beams (e. g. in a truss-analysis) only get y and x
+    if (model.getRodCount() == 0 || model.getNodeCount() == 0) {
+        return "there are no rods or nodes";
+    }
+    if (rodTypes.size() != model.getRodCount()) {
+        return "the rod-types do not match the model!";
+    }
+    int nodeCount = model.getNodeCount();
+    QVector<int> rodsAtNode(nodeCount, 0);
+    QVector<int> beamsAtNode(nodeCount, 0);
+    for (int e = 0; e < model.getRodCount(); e++) {
+        int beam = rodTypes.at(e) == RodType::Beam ? 1 : 0;
+        rodsAtNode[model.rodNode1.at(e)]++;
+        rodsAtNode[model.rodNode2.at(e)]++;
+        beamsAtNode[model.rodNode1.at(e)] += beam;
+        beamsAtNode[model.rodNode2.at(e)] += beam;
+    }
+    if (nodeOrder.size() != nodeCount) {
+        return "the node-order does not match the model!";
+    }
+    // node -> dofs
+    nodeFirstDof.resize(nodeCount);
+    nodeDofCount.resize(nodeCount);
+    for (int node : nodeOrder) {
+        int rotationDofs = model.nodeType.at(node) == NodeType::GerberJoint ? beamsAtNode.at(node) : qMin(beamsAtNode.at(node), 1);
+        nodeFirstDof[node] = dofCount;
+        nodeDofCount[node] = rodsAtNode.at(node) == 0 ? 0 : 2 + rotationDofs;
+        dofCount += nodeDofCount.at(node);
+    }
+    // rod -> dofs, in the order of the dof-map of the rod-type
+    QVector<int> usedRotationDofs(nodeCount, 0); // number of rotation-dofs of a gerber-joint that are already assigned to a beam
+    coincidenceTable.resize(model.getRodCount());
+    for (int e = 0; e < model.getRodCount(); e++) {
+        QVector<int> &dofGlobal = coincidenceTable[e];
+        visitRodType(rodTypes.at(e), [&](auto traits) {
+            numberRodDofs<decltype(traits)>(model, e, nodeFirstDof, usedRotationDofs, dofGlobal);
+        });
+        // coincidence-table, e. g.:
+        // | element | DOF local  | 1 | 2 | 3 | 4 | 5 | 6 |
+        // |   (1)   | DOF global | 2 | 8 | 4 | 5 | 1 | 3 |
+        // |   (2)   | DOF global | 4 | 5 | 7 | 9 | 3 | 6 |
+        // note: actually the indexing of the elements and DOFs starts at 0, not at 1 like in the example given above
+    }
+    return "";
+}
+
+QString Calculator::determineESM(const TrussModel &model, const QVector<RodType> &rodTypes, int threadCount, QVector<ElementMatrix> &k_es,
+                                QVector<Eigen::Matrix6d> &T_es)
+{
+    // the rods are computed in batches (see ElementKernel), one contiguous range of rods per thread, the ESM of a rod does not depend on the range it is part of
+    int rodCount = model.getRodCount();
+    ElementKernel::RodArrays rods = ElementKernel::gatherRods(model, rodTypes);
+    InstructionSet instructionSet = ElementKernel::detectInstructionSet();
+    k_es.resize(rodCount);
+    T_es.resize(rodCount);
+    ElementMatrix *k = k_es.data(); // detach here and not on the threads
+    Eigen::Matrix6d *T = T_es.data();
+    int rangeCount = Parallel::determineRangeCount(rodCount, Parallel::determineThreadCount(threadCount), Parallel::minRodsPerThread);
+    Parallel::forEachRange(rodCount, rangeCount, [&rods, k, T, instructionSet](int, int begin, int end) {
+        ElementKernel::determineElementMatrices(rods, begin, end, k, T, instructionSet);
+    });
+    return ""; // everything went ok, indicate this to the caller-fct by returning an empty string
+}
+
+QString Calculator::assembleGSM(int dofCount, int rodCount, const QVector<QVector<int>> &coincidenceTable, const QVector<ElementMatrix> &k_es,
+                                Eigen::MatrixXd &K)
+{
+    for (int e = 0; e < rodCount; e++) {
+        Eigen::MatrixXd K_tilde_e = Eigen::MatrixXd::Zero(dofCount, dofCount);
+        auto k_e = k_es.at(e);
+        for (int row = 0; row < k_e.rows(); row++) { // apply the coincidence-table to set the correct values for the element-GSM
+            for (int col = 0; col < k_e.cols(); col++) {
+                K_tilde_e(coincidenceTable.at(e).at(row), coincidenceTable.at(e).at(col)) = k_e(row, col);
+            }
+        }
+        K += K_tilde_e; // the GSM is the sum of all element-GSMs
+    }
+    return "";
+}
+
+QString Calculator::assembleSparseGSM(int dofCount, int rodCount, const QVector<QVector<int>> &coincidenceTable, const QVector<ElementMatrix> &k_es, int threadCount,
+                                      Eigen::SparseMatrix<double> &K)
+{
+    // instead of adding dofCount x dofCount element-GSMs, every entry of the ESMs is stored as a triplet (global row, global col, value) using the coincidence-table
+    // every thread fills the triplet-buffer of its range of rods, then the buffers are merged column by column, the entries of a column keep the order of the rods,
+    // therefore every K(i, j) gets summed up in the same order for any number of threads and K is bit-identical
+    int rangeCount = Parallel::determineRangeCount(rodCount, Parallel::determineThreadCount(threadCount), Parallel::minRodsPerThread);
+    QVector<QVector<Eigen::Triplet<double>>> buffers(rangeCount);
+    QVector<QVector<int>> columnCounts(rangeCount, QVector<int>(dofCount, 0)); // entries of every column in the buffer of a range, then the offset of the range in the column
+    QVector<Eigen::Triplet<double>> *buffer = buffers.data(); // detach here and not on the threads
+    QVector<int *> columnCount(rangeCount);
+    for (int range = 0; range < rangeCount; range++) {
+        columnCount[range] = columnCounts[range].data();
+    }
+    Parallel::forEachRange(rodCount, rangeCount, [&](int range, int begin, int end) {
+        QVector<Eigen::Triplet<double>> &triplets = buffer[range];
+        int *count = columnCount.at(range);
+        triplets.reserve(36 * (end - begin)); // every ESM contributes up to 6 x 6 entries
+        for (int e = begin; e < end; e++) {
+            const auto &dofGlobal = coincidenceTable.at(e);
+            const auto &k_e = k_es.at(e);
+            for (int col = 0; col < k_e.cols(); col++) {
+                for (int row = 0; row < k_e.rows(); row++) {
+                    triplets.append(Eigen::Triplet<double>(dofGlobal.at(row), dofGlobal.at(col), k_e(row, col)));
+                }
+                count[dofGlobal.at(col)] += k_e.rows();
+            }
+        }
+    });
+
+    // first entry of every column, the ranges follow each other within a column
+    QVector<int> columnStart(dofCount + 1, 0);
+    int *start = columnStart.data();
+    Parallel::forEachRange(dofCount, rangeCount, [&](int, int begin, int end) {
+        for (int col = begin; col < end; col++) {
+            int entries = 0;
+            for (int range = 0; range < rangeCount; range++) {
+                int rangeEntries = columnCount.at(range)[col];
+                columnCount.at(range)[col] = entries;
+                entries += rangeEntries;
+            }
+            start[col + 1] = entries;
+        }
+    });
+    for (int col = 0; col < dofCount; col++) {
+        start[col + 1] += start[col];
+    }
+
+    // move the triplets into their columns, then sort every column by rows (stable, so the entries of a row stay in the order of the rods) and sum up the duplicates
+    QVector<int> rows(start[dofCount]);
+    QVector<double> values(start[dofCount]);
+    int *row = rows.data();
+    double *value = values.data();
+    Parallel::forEachRange(rodCount, rangeCount, [&](int range, int, int) {
+        int *offset = columnCount.at(range);
+        const QVector<Eigen::Triplet<double>> &triplets = buffer[range];
+        for (const Eigen::Triplet<double> &triplet : triplets) {
+            int position = start[triplet.col()] + offset[triplet.col()]++;
+            row[position] = triplet.row();
+            value[position] = triplet.value();
+        }
+    });
+    buffers.clear();
+    QVector<int> nonZeros(dofCount + 1, 0); // non-zeros of every column after merging, shifted by one for the prefix-sum below
+    int *columnNonZeros = nonZeros.data();
+    Parallel::forEachRange(dofCount, rangeCount, [&](int, int begin, int end) {
+        std::vector<std::pair<int, double>> entries;
+        for (int col = begin; col < end; col++) {
+            int first = start[col];
+            int last = start[col + 1];
+            if (last - first > maxInsertionSortLength) {
+                entries.clear();
+                for (int i = first; i < last; i++) {
+                    entries.emplace_back(row[i], value[i]);
+                }
+                std::stable_sort(entries.begin(), entries.end(), [](const std::pair<int, double> &a, const std::pair<int, double> &b) { return a.first < b.first; });
+                for (int i = first; i < last; i++) {
+                    row[i] = entries.at(i - first).first;
+                    value[i] = entries.at(i - first).second;
+                }
+            } else {
+                for (int i = first + 1; i < last; i++) {
+                    int r = row[i];
+                    double v = value[i];
+                    int j = i;
+                    for (; j > first && row[j - 1] > r; j--) {
+                        row[j] = row[j - 1];
+                        value[j] = value[j - 1];
+                    }
+                    row[j] = r;
+                    value[j] = v;
+                }
+            }
+            int merged = first; // the merged entries are written to the front of the column
+            for (int i = first; i < last; i++) {
+                if (i > first && row[i] == row[merged - 1]) {
+                    value[merged - 1] += value[i];
+                } else {
+                    row[merged] = row[i];
+                    value[merged] = value[i];
+                    merged++;
+                }
+            }
+            columnNonZeros[col + 1] = merged - first;
+        }
+    });
+
+    // copy the merged columns into the compressed storage of K
+    for (int col = 0; col < dofCount; col++) {
+        columnNonZeros[col + 1] += columnNonZeros[col];
+    }
+    K.resize(dofCount, dofCount);
+    K.resizeNonZeros(columnNonZeros[dofCount]);
+    std::copy(columnNonZeros, columnNonZeros + dofCount + 1, K.outerIndexPtr());
+    int *innerIndex = K.innerIndexPtr();
+    double *valueOut = K.valuePtr();
+    Parallel::forEachRange(dofCount, rangeCount, [&](int, int begin, int end) {
+        for (int col = begin; col < end; col++) {
+            int count = columnNonZeros[col + 1] - columnNonZeros[col];
+            std::copy(row + start[col], row + start[col] + count, innerIndex + columnNonZeros[col]);
+            std::copy(value + start[col], value + start[col] + count, valueOut + columnNonZeros[col]);
+        }
+    });
+    return "";
+}
+
+QString Calculator::applyConstraints(const TrussModel &model, const QVector<int> &nodeFirstDof, const QVector<int> &nodeDofCount, Eigen::MatrixXd &F,
+                                     Eigen::VectorXb &F_k, Eigen::MatrixXd &U, Eigen::VectorXb &U_k)
+{
+    // boundary-conditions are applied in this fct, transition-conditions get applied in the numbering of the dofs in numberDofs()
+    // the supports are the same in every load-case, only the applied loads differ from column to column
+    auto setKnownU = [&U, &U_k](int dof, double value) {
+        U.row(dof).setConstant(value);
+        U_k(dof) = true;
+    };
+    auto setKnownF = [&F, &F_k](int dof, double value) {
+        F.row(dof).setConstant(value);
+        F_k(dof) = true;
+    };
+    auto setKnownLoads = [&model, &F, &F_k](int dof, int node, const QVector<double> &loads, double sign) {
+        for (int loadCase = 0; loadCase < model.getLoadCaseCount(); loadCase++) {
+            F(dof, loadCase) = sign * loads.at(model.getLoadIndex(node, loadCase));
+        }
+        F_k(dof) = true;
+    };
+    for (int node = 0; node < model.getNodeCount(); node++) {
+        int first = nodeFirstDof.at(node);
+        int end = first + nodeDofCount.at(node);
+        if (first == end) { // node without rods
+            continue;
+        }
+        int y = first;
+        int x = first + 1;
+        if (model.nodeHasBearing.at(node)) { // if a bearing is at a node, the nodes movement is restricted depending on the kind of the bearing
+            visitBearingType(model.nodeBearingType.at(node), [&](auto traits) {
+                typedef decltype(traits) Bearing;
+                if (Bearing::fixesY) {
+                    setKnownU(y, 0); // y-direction immoveable
+                } else {
+                    setKnownF(y, 0); // y-direction force-free
+                }
+                if (Bearing::fixesX) {
+                    setKnownU(x, 0); // x-direction immoveable
+                } else {
+                    setKnownF(x, 0); // x-direction force-free
+                }
+                for (int m = first + 2; m < end; m++) {
+                    if (Bearing::fixesRotation) {
+                        setKnownU(m, 0); // z-direction not rotable
+                    } else {
+                        setKnownF(m, 0); // z-direction moment-free
+                    }
+                }
+            });
+        } else { // if there is no bearing on a node account for applied forces (because SUM(F_node_i) = F_node_applied (or 0 if no force is applied))
+            setKnownLoads(x, node, model.nodeFx, 1); // x, positive axis direction is to the right (in calculator and in system definition)
+            setKnownLoads(y, node, model.nodeFy, -1); // y, positive axis direction in calculator is downwards, in system definition it is upwards, therefore -
+            for (int m = first + 2; m < end; m++) {
+                setKnownLoads(m, node, model.nodeMz, 1); // z, positive moment turns counterclockwise (same in calculator and in system definition)
+            }
+        }
+    }
+    return "";
+}
+
+QString Calculator::determineInnerForces(const TrussModel &model, const QVector<RodType> &rodTypes, const QVector<QVector<int>> &coincidenceTable, const Eigen::MatrixXd &U,
+                                         Eigen::MatrixXd &innerForces)
+{
+    innerForces.resize(model.getRodCount(), U.cols());
+    for (int e = 0; e < model.getRodCount(); e++) { // every row holds the normal-force of one rod in all load-cases
+        const QVector<int> &dof = coincidenceTable.at(e);
+        double angle = model.getRodAngle(e); // calculate the inner-normal-forces of the rods depending on the displacements of the connected nodes
+        visitRodType(rodTypes.at(e), [&](auto traits) {
+            typedef decltype(traits) Traits;
+            Eigen::RowVectorXd u1_e_local = U.row(dof.at(Traits::x(0))) * cos(angle) - U.row(dof.at(Traits::y(0))) * sin(angle); // - because the y-axis is downwards positive
+            Eigen::RowVectorXd u2_e_local = U.row(dof.at(Traits::x(1))) * cos(angle) - U.row(dof.at(Traits::y(1))) * sin(angle);
+            Eigen::RowVectorXd deltaU = u2_e_local - u1_e_local; // u2 - u1 because then deltaU is positive in case of rod-elongation (which means the force is pulling)
+            innerForces.row(e) = model.rodE.at(e) * model.rodA.at(e) * deltaU / model.getRodLength(e); // sigma=E*epsilon, sigma=F/a and epsilon=deltaU/l => F=E*A*deltaU/l
+        });
+    }
+    return "";
+}
@@ -0,0 +1,380 @@
+#include "dofordering.h"
+
+#include "libs/Eigen/Eigen/Eigen"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    typedef QVector<QVector<int>> Graph; // adjacency-lists, sorted and without self-loops
+
+    Graph buildNodeGraph(const TrussModel &model)
+    {
+        Graph graph(model.getNodeCount());
+        for (int e = 0; e < model.getRodCount(); e++) {
+            int node1 = model.rodNode1.at(e);
+            int node2 = model.rodNode2.at(e);
+            if (node1 != node2) {
+                graph[node1].append(node2);
+                graph[node2].append(node1);
+            }
+        }
+        for (auto &adjacent : graph) { // several rods between the same nodes are one edge
+            std::sort(adjacent.begin(), adjacent.end());
+            adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+        }
+        return graph;
+    }
+
+    class LevelStructure // breadth-first-search restricted to the nodes of one region of the graph
+    {
+    public:
+        explicit LevelStructure(const Graph &graph) : graph(graph), region(graph.size(), 0), level(graph.size(), -1) {}
+
+        int build(int root, int regionId) // returns the number of levels, the reached nodes are stored in bfs-order
+        {
+            for (int node : reached) { // only the nodes reached by the last call have a level, this keeps the costs proportional to the size of the region
+                level[node] = -1;
+            }
+            reached.clear();
+            reached.append(root);
+            level[root] = 0;
+            for (int head = 0; head < reached.size(); head++) {
+                int node = reached.at(head);
+                for (int adjacent : graph.at(node)) {
+                    if (region.at(adjacent) == regionId && level.at(adjacent) == -1) {
+                        level[adjacent] = level.at(node) + 1;
+                        reached.append(adjacent);
+                    }
+                }
+            }
+            return level.at(reached.last()) + 1;
+        }
+
+        int findPseudoPeripheralNode(int start, int regionId) // george-liu: move to a node of minimal degree in the last level as long as the eccentricity grows
+        {
+            int root = start;
+            int levels = build(root, regionId);
+            while (true) {
+                int candidate = -1;
+                for (int i = reached.size() - 1; i >= 0 && level.at(reached.at(i)) == levels - 1; i--) {
+                    if (candidate == -1 || graph.at(reached.at(i)).size() < graph.at(candidate).size()) {
+                        candidate = reached.at(i);
+                    }
+                }
+                int candidateLevels = build(candidate, regionId);
+                if (candidateLevels <= levels) {
+                    build(root, regionId); // restore the level-structure of the root
+                    return root;
+                }
+                root = candidate;
+                levels = candidateLevels;
+            }
+        }
+
+        const Graph &graph;
+        QVector<int> region; // region-id of every node
+        QVector<int> level; // only valid for the nodes reached by the last build()
+        QVector<int> reached;
+    };
+
+    QVector<int> reverseCuthillMcKee(const Graph &graph)
+    {
+        int n = graph.size();
+        auto byDegree = [&graph](int a, int b) { return graph.at(a).size() < graph.at(b).size(); };
+        QVector<int> seeds(n);
+        std::iota(seeds.begin(), seeds.end(), 0);
+        std::stable_sort(seeds.begin(), seeds.end(), byDegree);
+        LevelStructure levelStructure(graph);
+        QVector<bool> visited(n, false);
+        QVector<int> order;
+        order.reserve(n);
+        for (int seed : seeds) { // one pass per connected component
+            if (visited.at(seed)) {
+                continue;
+            }
+            int root = levelStructure.findPseudoPeripheralNode(seed, 0);
+            int first = order.size();
+            order.append(root);
+            visited[root] = true;
+            for (int head = first; head < order.size(); head++) {
+                int begin = order.size();
+                for (int adjacent : graph.at(order.at(head))) {
+                    if (!visited.at(adjacent)) {
+                        visited[adjacent] = true;
+                        order.append(adjacent);
+                    }
+                }
+                std::stable_sort(order.begin() + begin, order.end(), byDegree); // visit the neighbours with the smallest degree first
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    QVector<int> approximateMinimumDegree(const Graph &graph)
+    {
+        int n = graph.size();
+        QVector<Eigen::Triplet<double>> triplets;
+        for (int node = 0; node < n; node++) {
+            triplets.append(Eigen::Triplet<double>(node, node, 1));
+            for (int adjacent : graph.at(node)) {
+                triplets.append(Eigen::Triplet<double>(node, adjacent, 1));
+            }
+        }
+        Eigen::SparseMatrix<double> pattern(n, n);
+        pattern.setFromTriplets(triplets.begin(), triplets.end());
+        Eigen::AMDOrdering<int>::PermutationType permutation;
+        Eigen::AMDOrdering<int>()(pattern, permutation); // the k-th index is the node that is eliminated k-th
+        return QVector<int>(permutation.indices().data(), permutation.indices().data() + n);
+    }
+
+    class NestedDissection
+    {
+    public:
+        explicit NestedDissection(const Graph &graph) : levelStructure(graph), nextRegionId(1) {}
+
+        QVector<int> determineOrder()
+        {
+            QVector<int> allNodes(levelStructure.graph.size());
+            std::iota(allNodes.begin(), allNodes.end(), 0);
+            order.reserve(allNodes.size());
+            dissectComponents(allNodes, 0);
+            return order;
+        }
+
+    private:
+        void dissectComponents(const QVector<int> &nodes, int regionId) // splits the region into its connected components and dissects each of them
+        {
+            for (int node : nodes) {
+                if (levelStructure.region.at(node) != regionId) {
+                    continue; // already moved to the region of a component
+                }
+                levelStructure.build(node, regionId);
+                QVector<int> component = levelStructure.reached;
+                int componentId = nextRegionId++;
+                for (int member : component) {
+                    levelStructure.region[member] = componentId;
+                }
+                dissect(component, componentId);
+            }
+        }
+
+        void dissect(const QVector<int> &nodes, int regionId) // nodes is connected
+        {
+            if (nodes.size() <= 8) { // too small to gain anything
+                order.append(nodes);
+                return;
+            }
+            int levels = levelStructure.build(levelStructure.findPseudoPeripheralNode(nodes.first(), regionId), regionId);
+            if (levels < 3) { // no separator possible
+                order.append(nodes);
+                return;
+            }
+            // the nodes of one level separate the lower levels from the higher ones, use the level that splits the region in halves
+            QVector<int> countPerLevel(levels, 0);
+            for (int node : nodes) {
+                countPerLevel[levelStructure.level.at(node)]++;
+            }
+            int separatorLevel = 1;
+            for (int sum = countPerLevel.first(); separatorLevel < levels - 2 && sum + countPerLevel.at(separatorLevel) <= nodes.size() / 2; separatorLevel++) {
+                sum += countPerLevel.at(separatorLevel);
+            }
+            QVector<int> lowerPart, upperPart, separator;
+            for (int node : nodes) {
+                int nodeLevel = levelStructure.level.at(node);
+                if (nodeLevel < separatorLevel) {
+                    lowerPart.append(node);
+                } else if (nodeLevel > separatorLevel) {
+                    upperPart.append(node);
+                } else {
+                    separator.append(node);
+                }
+            }
+            for (const QVector<int> *part : {&lowerPart, &upperPart}) {
+                int partId = nextRegionId++;
+                for (int node : *part) {
+                    levelStructure.region[node] = partId;
+                }
+                dissectComponents(*part, partId); // the parts are not necessarily connected
+            }
+            for (int node : separator) {
+                levelStructure.region[node] = -1; // already numbered
+            }
+            order.append(separator); // separators are eliminated last, this limits the fill to the separator-blocks
+        }
+
+        LevelStructure levelStructure;
+        int nextRegionId;
+        QVector<int> order;
+    };
+
+    QVector<int> eliminationTree(const Graph &graph) // parent of every column in the elimination-tree of the cholesky-factor (-1 for roots)
+    {
+        int n = graph.size();
+        QVector<int> parent(n, -1);
+        QVector<int> ancestor(n, -1); // path-compressed ancestors
+        for (int k = 0; k < n; k++) {
+            for (int i : graph.at(k)) {
+                while (i != -1 && i < k) {
+                    int next = ancestor.at(i);
+                    ancestor[i] = k;
+                    if (next == -1) {
+                        parent[i] = k;
+                    }
+                    i = next;
+                }
+            }
+        }
+        return parent;
+    }
+
+    QVector<int> postOrder(const QVector<int> &parent)
+    {
+        int n = parent.size();
+        QVector<int> head(n, -1), next(n, -1), post, stack;
+        post.reserve(n);
+        for (int j = n - 1; j >= 0; j--) { // children-lists
+            if (parent.at(j) != -1) {
+                next[j] = head.at(parent.at(j));
+                head[parent.at(j)] = j;
+            }
+        }
+        for (int root = 0; root < n; root++) {
+            if (parent.at(root) != -1) {
+                continue;
+            }
+            stack.append(root);
+            while (!stack.isEmpty()) {
+                int p = stack.last();
+                int child = head.at(p);
+                if (child == -1) {
+                    stack.removeLast();
+                    post.append(p);
+                } else {
+                    head[p] = next.at(child);
+                    stack.append(child);
+                }
+            }
+        }
+        return post;
+    }
+
+    qint64 countFactorNonZeros(const Graph &graph) // column-counts of the cholesky-factor with the algorithm of gilbert, ng and peyton (skeleton-matrix and least common ancestors)
+    {
+        int n = graph.size();
+        QVector<int> parent = eliminationTree(graph);
+        QVector<int> post = postOrder(parent);
+        QVector<int> first(n, -1), maxFirst(n, -1), previousLeaf(n, -1), ancestor(n);
+        QVector<qint64> delta(n, 0);
+        for (int k = 0; k < n; k++) {
+            int j = post.at(k);
+            delta[j] = first.at(j) == -1 ? 1 : 0; // 1 if j is a leaf
+            for (; j != -1 && first.at(j) == -1; j = parent.at(j)) {
+                first[j] = k;
+            }
+        }
+        std::iota(ancestor.begin(), ancestor.end(), 0);
+        for (int k = 0; k < n; k++) {
+            int j = post.at(k);
+            if (parent.at(j) != -1) {
+                delta[parent.at(j)]--;
+            }
+            for (int i : graph.at(j)) {
+                if (i <= j || first.at(j) <= maxFirst.at(i)) {
+                    continue; // j is not a leaf of the row-subtree of i
+                }
+                maxFirst[i] = first.at(j);
+                int jPrevious = previousLeaf.at(i);
+                previousLeaf[i] = j;
+                delta[j]++; // K(i, j) is in the skeleton-matrix
+                if (jPrevious != -1) { // subtract the overlap with the previous leaf at their least common ancestor
+                    int q = jPrevious;
+                    while (q != ancestor.at(q)) {
+                        q = ancestor.at(q);
+                    }
+                    for (int s = jPrevious; s != q;) {
+                        int sParent = ancestor.at(s);
+                        ancestor[s] = q;
+                        s = sParent;
+                    }
+                    delta[q]--;
+                }
+            }
+            if (parent.at(j) != -1) {
+                ancestor[j] = parent.at(j);
+            }
+        }
+        for (int j = 0; j < n; j++) { // the column-count is the sum of the deltas of the subtree (children have smaller indices than their parents)
+            if (parent.at(j) != -1) {
+                delta[parent.at(j)] += delta.at(j);
+            }
+        }
+        return std::accumulate(delta.begin(), delta.end(), qint64(0));
+    }
+} // end anonymous namespace
+
+QVector<int> Ordering::determineNodeOrder(const TrussModel &model, DofOrdering ordering)
+{
+    if (ordering == DofOrdering::Natural) {
+        QVector<int> order(model.getNodeCount());
+        std::iota(order.begin(), order.end(), 0);
+        return order;
+    }
+    Graph graph = buildNodeGraph(model);
+    switch (ordering) {
+    case DofOrdering::ReverseCuthillMcKee:
+        return reverseCuthillMcKee(graph);
+    case DofOrdering::ApproximateMinimumDegree:
+        return approximateMinimumDegree(graph);
+    default: // DofOrdering::NestedDissection
+        return NestedDissection(graph).determineOrder();
+    }
+}
+
+OrderingMetrics Ordering::determineMetrics(int dofCount, const QVector<QVector<int>> &coincidenceTable)
+{
+    Graph graph(dofCount); // pattern of the GSM without the diagonal
+    for (const QVector<int> &dofs : coincidenceTable) {
+        for (int i : dofs) {
+            for (int j : dofs) {
+                if (i != j) {
+                    graph[i].append(j);
+                }
+            }
+        }
+    }
+    OrderingMetrics metrics;
+    for (int i = 0; i < dofCount; i++) {
+        QVector<int> &adjacent = graph[i];
+        std::sort(adjacent.begin(), adjacent.end());
+        adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+        if (!adjacent.isEmpty()) {
+            metrics.bandwidth = std::max({metrics.bandwidth, i - adjacent.first(), adjacent.last() - i});
+            metrics.profile += std::max(0, i - adjacent.first());
+        }
+    }
+    metrics.factorNonZeros = countFactorNonZeros(graph);
+    return metrics;
+}
+
+QString Ordering::toString(DofOrdering ordering)
+{
+    switch (ordering) {
+    case DofOrdering::Natural:
+        return "Natürlich";
+    case DofOrdering::ReverseCuthillMcKee:
+        return "Reverse Cuthill-McKee";
+    case DofOrdering::ApproximateMinimumDegree:
+        return "Approximate Minimum Degree";
+    default:
+        return "Nested Dissection";
+    }
+}
+
+QString Ordering::compare(const OrderingMetrics &before, const OrderingMetrics &after)
+{
+    return QString("Bandbreite %1 → %2, Profil %3 → %4, nnz(L) %5 → %6").arg(before.bandwidth).arg(after.bandwidth).arg(before.profile).arg(after.profile)
+           .arg(before.factorNonZeros).arg(after.factorNonZeros);
+}
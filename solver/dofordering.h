@@ -0,0 +1,34 @@
+#ifndef DOFORDERING_H
+#define DOFORDERING_H
+
+#include "solver/trussmodel.h"
+
+#include <QString>
+#include <QVector>
+
+enum class DofOrdering : int {
+    Natural = 0, // nodes in the order of the model, the sparse solvers apply their own fill-reducing ordering
+    ReverseCuthillMcKee = 1, // bandwidth-reducing
+    ApproximateMinimumDegree = 2, // fill-reducing
+    NestedDissection = 3 // fill-reducing, separators are numbered last
+};
+
+struct OrderingMetrics // describes the sparsity-pattern of the GSM for a given numbering of the dofs
+{
+    int bandwidth = 0; // max |i - j| of all non-zero entries K(i, j)
+    qint64 profile = 0; // sum over all rows of the distance between the diagonal and the first non-zero entry of the row
+    qint64 factorNonZeros = 0; // predicted non-zeros of the cholesky-factor L (including the diagonal)
+};
+
+namespace Ordering
+{
+    // the orderings work on the graph of the nodes (connected by rods), the dofs of a node are kept together and numbered in the order of the returned nodes
+    QVector<int> determineNodeOrder(const TrussModel &model, DofOrdering ordering); // returns the indices of the nodes in the new order
+
+    OrderingMetrics determineMetrics(int dofCount, const QVector<QVector<int>> &coincidenceTable); // symbolic only, no values of K are needed
+
+    QString toString(DofOrdering ordering);
+    QString compare(const OrderingMetrics &before, const OrderingMetrics &after); // e.g. for the status-bar
+}
+
+#endif // DOFORDERING_H
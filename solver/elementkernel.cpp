@@ -0,0 +1,152 @@
+#include "solver/elementkernel.h"
+
+#include "solver/elementkernelsimd.h"
+#include "solver/elementtraits.h"
+
+#if defined(_MSC_VER) && defined(ELEMENTKERNEL_X86)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    bool cpuSupportsAvx()
+    {
+#if defined(ELEMENTKERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx"); // also checks that the os saves the ymm-registers
+#elif defined(ELEMENTKERNEL_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6; // xmm- and ymm-state enabled by the os
+#else
+        return false;
+#endif
+    }
+
+    template<typename Traits>
+    void scatterElementMatrix(const Eigen::Matrix<double, Eigen::Dynamic, 9> &values, int id, Calculator::ElementMatrix &k_e)
+    {
+        // the ESM is built from the couplings of the nodes a and b: the y- and x-terms are positive for a == b and negative between the nodes,
+        // the displacements of node1 couple with the rotations by - b * c (y) and - b * s (x), the ones of node2 by + b * c and + b * s
+        double yy = values(id, 2);
+        double yx = values(id, 3);
+        double xx = values(id, 4);
+        k_e.resize(Traits::dofCount, Traits::dofCount);
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 2; b++) {
+                double sign = a == b ? 1 : -1;
+                k_e(Traits::y(a), Traits::y(b)) = sign * yy;
+                k_e(Traits::y(a), Traits::x(b)) = sign * yx;
+                k_e(Traits::x(a), Traits::y(b)) = sign * yx;
+                k_e(Traits::x(a), Traits::x(b)) = sign * xx;
+                if (Traits::hasBending) {
+                    double bc = a == 0 ? - values(id, 5) : values(id, 5);
+                    double bs = a == 0 ? - values(id, 6) : values(id, 6);
+                    k_e(Traits::y(a), Traits::m(b)) = bc;
+                    k_e(Traits::m(b), Traits::y(a)) = bc;
+                    k_e(Traits::x(a), Traits::m(b)) = bs;
+                    k_e(Traits::m(b), Traits::x(a)) = bs;
+                    k_e(Traits::m(a), Traits::m(b)) = a == b ? values(id, 7) : values(id, 8); // d on the diagonal, e between the nodes
+                }
+            }
+        }
+    }
+} // end anonymous namespace
+
+void ElementKernel::Detail::computeScalar(const ElementKernelArrays &arrays)
+{
+    compute<ScalarPack>(arrays, 0);
+}
+
+void ElementKernel::Detail::computeSse2(const ElementKernelArrays &arrays)
+{
+#ifdef ELEMENTKERNEL_SSE2
+    compute<ScalarPack>(arrays, compute<Sse2Pack>(arrays, 0)); // the remaining rod one by one
+#else
+    compute<ScalarPack>(arrays, 0);
+#endif
+}
+
+ElementKernel::RodArrays ElementKernel::gatherRods(const TrussModel &model, const QVector<RodType> &rodTypes)
+{
+    int rodCount = model.getRodCount();
+    RodArrays rods;
+    rods.dx.resize(rodCount);
+    rods.dy.resize(rodCount);
+    rods.I.resize(rodCount);
+    for (int e = 0; e < rodCount; e++) {
+        rods.dx[e] = model.nodeX.at(model.rodNode2.at(e)) - model.nodeX.at(model.rodNode1.at(e));
+        rods.dy[e] = model.nodeY.at(model.rodNode2.at(e)) - model.nodeY.at(model.rodNode1.at(e));
+        visitRodType(rodTypes.at(e), [&rods, &model, e](auto traits) {
+            rods.I[e] = decltype(traits)::bendingStiffness(model.rodI.at(e));
+        });
+    }
+    rods.E = model.rodE; // implicitly shared, no copy
+    rods.A = model.rodA;
+    rods.type = rodTypes;
+    return rods;
+}
+
+void ElementKernel::determineElementMatrices(const RodArrays &rods, int begin, int end, Calculator::ElementMatrix *k_es, Eigen::Matrix6d *T_es,
+                                             InstructionSet instructionSet)
+{
+    int rodCount = end - begin;
+    Eigen::Matrix<double, Eigen::Dynamic, 9> values(rodCount, 9); // c, s, yy, yx, xx, bc, bs, d, e (every column is one output-array of the kernel)
+    ElementKernelArrays arrays{rods.dx.constData() + begin, rods.dy.constData() + begin, rods.E.constData() + begin, rods.A.constData() + begin,
+                               rods.I.constData() + begin, rodCount, values.col(0).data(), values.col(1).data(), values.col(2).data(), values.col(3).data(),
+                               values.col(4).data(), values.col(5).data(), values.col(6).data(), values.col(7).data(), values.col(8).data()};
+    if (rodCount > 0) {
+        if (instructionSet == InstructionSet::AVX) {
+            Detail::computeAvx(arrays);
+        } else if (instructionSet == InstructionSet::SSE2) {
+            Detail::computeSse2(arrays);
+        } else {
+            Detail::computeScalar(arrays);
+        }
+    }
+
+    // scatter the distinct values into the ESMs, in the layout of the dof-map of the rod-type
+    for (int id = 0; id < rodCount; id++) {
+        double c = values(id, 0);
+        double s = values(id, 1);
+        Calculator::ElementMatrix &k_e = k_es[begin + id];
+        visitRodType(rods.type.at(begin + id), [&values, id, &k_e](auto traits) {
+            scatterElementMatrix<decltype(traits)>(values, id, k_e);
+        });
+        Eigen::Matrix6d &T_e = T_es[begin + id]; // element-transformation-matrix
+        T_e.setIdentity();
+        T_e(0, 0) = c;
+        T_e(0, 4) = s;
+        T_e(2, 2) = c;
+        T_e(2, 5) = s;
+        T_e(4, 0) = - s;
+        T_e(4, 4) = c;
+        T_e(5, 2) = - s;
+        T_e(5, 5) = c;
+    }
+}
+
+InstructionSet ElementKernel::detectInstructionSet()
+{
+    static const InstructionSet detected = cpuSupportsAvx() ? InstructionSet::AVX :
+#ifdef ELEMENTKERNEL_SSE2
+                                                              InstructionSet::SSE2;
+#else
+                                                              InstructionSet::Scalar;
+#endif
+    return detected;
+}
+
+QString ElementKernel::toString(InstructionSet instructionSet)
+{
+    switch (instructionSet) {
+    case InstructionSet::Scalar:
+        return "Skalar";
+    case InstructionSet::SSE2:
+        return "SSE2";
+    default:
+        return "AVX";
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef ELEMENTKERNEL_H
+#define ELEMENTKERNEL_H
+
+#include "calculator.h"
+
+#include <QString>
+#include <QVector>
+
+enum class InstructionSet : int {
+    Scalar = 0,
+    SSE2 = 1, // 2 rods at once
+    AVX = 2 // 4 rods at once
+};
+
+namespace ElementKernel
+{
+    // the ESMs of all rods are computed in one batch: the rod-data is stored as a structure of arrays and the global ESMs are built from the closed-form
+    // expressions in the direction cosines (no trigonometric fcts, no T_e^T * k_e * T_e), vectorized across the rods with the best instruction-set of the cpu
+    struct RodArrays
+    {
+        QVector<double> dx; // x2 - x1 [m]
+        QVector<double> dy; // y2 - y1 [m], downwards positive
+        QVector<double> E;
+        QVector<double> A;
+        QVector<double> I; // 0 for bars and ropes, see ElementTraits::bendingStiffness()
+        QVector<RodType> type; // decides the layout of the ESM
+    };
+
+    RodArrays gatherRods(const TrussModel &model, const QVector<RodType> &rodTypes); // rodTypes see Calculator::determineRodTypes()
+    // fills the entries [begin, end) of k_es and T_es (which have one entry per rod), different ranges can be computed on different threads at once
+    void determineElementMatrices(const RodArrays &rods, int begin, int end, Calculator::ElementMatrix *k_es, Eigen::Matrix6d *T_es, InstructionSet instructionSet);
+
+    InstructionSet detectInstructionSet(); // the best instruction-set the cpu and the os support, determined once
+    QString toString(InstructionSet instructionSet);
+}
+
+#endif // ELEMENTKERNEL_H
@@ -0,0 +1,30 @@
+// this translation-unit is compiled for avx, ElementKernel::Detail::computeAvx() may only be called if the cpu supports it (see ElementKernel::detectInstructionSet())
+// it must not include Qt or Eigen, see elementkernelsimd.h
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx")
+#endif
+#define ELEMENTKERNEL_AVX_TARGET // msvc needs no flag to use the avx-intrinsics
+#endif
+
+#include "solver/elementkernelsimd.h"
+
+void ElementKernel::Detail::computeAvx(const ElementKernelArrays &arrays)
+{
+#ifdef ELEMENTKERNEL_AVX_TARGET
+    compute<ScalarPack>(arrays, compute<AvxPack>(arrays, 0)); // the remaining rods one by one
+#else
+    compute<ScalarPack>(arrays, 0);
+#endif
+}
+
+#ifdef ELEMENTKERNEL_AVX_TARGET
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
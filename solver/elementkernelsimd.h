@@ -0,0 +1,136 @@
+#ifndef ELEMENTKERNELSIMD_H
+#define ELEMENTKERNELSIMD_H
+
+// the element-kernel is included by translation-units that are compiled for different instruction-sets (see elementkernelavx.cpp)
+// therefore this file must not include Qt or Eigen, their inline-fcts would otherwise exist once per instruction-set and the linker could pick the wrong one
+// everything that is instantiated here lives in an anonymous namespace, so every translation-unit keeps its own copy
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ELEMENTKERNEL_X86
+#include <immintrin.h>
+#endif
+
+#include <cmath>
+
+struct ElementKernelArrays // structure of arrays, the entry i of every array belongs to the rod i
+{
+    // input
+    const double *dx; // x2 - x1 [m]
+    const double *dy; // y2 - y1 [m], downwards positive
+    const double *E;
+    const double *A;
+    const double *I; // 0 for bars and ropes, then all bending-terms vanish
+    int count;
+
+    // output, the distinct values of the global ESM (see ElementKernel::determineElementMatrices())
+    double *c; // direction cosines, T_e gets built from them
+    double *s;
+    double *yy; // a * c² + r * s² with a = 12 * EI / l³ and r = EA / l
+    double *yx; // c * s * (a - r)
+    double *xx; // a * s² + r * c²
+    double *bc; // b * c with b = 6 * EI / l²
+    double *bs; // b * s
+    double *d; // 4 * EI / l
+    double *e; // 2 * EI / l
+};
+
+namespace ElementKernel
+{
+    namespace Detail
+    {
+        void computeScalar(const ElementKernelArrays &arrays);
+        void computeSse2(const ElementKernelArrays &arrays);
+        void computeAvx(const ElementKernelArrays &arrays); // only call this if the cpu supports avx
+    }
+}
+
+namespace
+{
+    // the packs wrap the intrinsics of one instruction-set, compute() is written once for all of them
+    // every pack executes exactly the same ieee-operations in the same order (no fma), therefore the results do not depend on the instruction-set or on the lane of a rod
+    struct ScalarPack
+    {
+        typedef double Type;
+        static const int width = 1;
+        static Type load(const double *p) { return *p; }
+        static void store(double *p, Type v) { *p = v; }
+        static Type set(double v) { return v; }
+        static Type add(Type a, Type b) { return a + b; }
+        static Type sub(Type a, Type b) { return a - b; }
+        static Type mul(Type a, Type b) { return a * b; }
+        static Type div(Type a, Type b) { return a / b; }
+        static Type sqrt(Type a) { return std::sqrt(a); }
+    };
+
+#if defined(ELEMENTKERNEL_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ELEMENTKERNEL_SSE2
+    struct Sse2Pack
+    {
+        typedef __m128d Type;
+        static const int width = 2;
+        static Type load(const double *p) { return _mm_loadu_pd(p); }
+        static void store(double *p, Type v) { _mm_storeu_pd(p, v); }
+        static Type set(double v) { return _mm_set1_pd(v); }
+        static Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+        static Type sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+        static Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+        static Type div(Type a, Type b) { return _mm_div_pd(a, b); }
+        static Type sqrt(Type a) { return _mm_sqrt_pd(a); }
+    };
+#endif
+
+#if defined(ELEMENTKERNEL_X86) && defined(ELEMENTKERNEL_AVX_TARGET) // only defined in the translation-unit that is compiled for avx
+    struct AvxPack
+    {
+        typedef __m256d Type;
+        static const int width = 4;
+        static Type load(const double *p) { return _mm256_loadu_pd(p); }
+        static void store(double *p, Type v) { _mm256_storeu_pd(p, v); }
+        static Type set(double v) { return _mm256_set1_pd(v); }
+        static Type add(Type a, Type b) { return _mm256_add_pd(a, b); }
+        static Type sub(Type a, Type b) { return _mm256_sub_pd(a, b); }
+        static Type mul(Type a, Type b) { return _mm256_mul_pd(a, b); }
+        static Type div(Type a, Type b) { return _mm256_div_pd(a, b); }
+        static Type sqrt(Type a) { return _mm256_sqrt_pd(a); }
+    };
+#endif
+
+    template<typename Pack>
+    int compute(const ElementKernelArrays &k, int first) // computes Pack::width rods at once, returns the first rod that is left over (less than Pack::width rods)
+    {
+        typedef typename Pack::Type V;
+        const V zero = Pack::set(0);
+        const V two = Pack::set(2);
+        const V four = Pack::set(4);
+        const V six = Pack::set(6);
+        const V twelve = Pack::set(12);
+        int i = first;
+        for (; i + Pack::width <= k.count; i += Pack::width) {
+            V dx = Pack::load(k.dx + i);
+            V dy = Pack::load(k.dy + i);
+            V l2 = Pack::add(Pack::mul(dx, dx), Pack::mul(dy, dy));
+            V l = Pack::sqrt(l2);
+            V c = Pack::div(dx, l);
+            V s = Pack::div(Pack::sub(zero, dy), l); // - because the y-axis is downwards positive, see TrussModel::getRodAngle()
+            V E = Pack::load(k.E + i);
+            V EI_l = Pack::div(Pack::mul(E, Pack::load(k.I + i)), l);
+            V r = Pack::div(Pack::mul(E, Pack::load(k.A + i)), l);
+            V a = Pack::div(Pack::mul(twelve, EI_l), l2);
+            V b = Pack::div(Pack::mul(six, EI_l), l);
+            V cc = Pack::mul(c, c);
+            V ss = Pack::mul(s, s);
+            Pack::store(k.c + i, c);
+            Pack::store(k.s + i, s);
+            Pack::store(k.yy + i, Pack::add(Pack::mul(a, cc), Pack::mul(r, ss)));
+            Pack::store(k.yx + i, Pack::mul(Pack::mul(c, s), Pack::sub(a, r)));
+            Pack::store(k.xx + i, Pack::add(Pack::mul(a, ss), Pack::mul(r, cc)));
+            Pack::store(k.bc + i, Pack::mul(b, c));
+            Pack::store(k.bs + i, Pack::mul(b, s));
+            Pack::store(k.d + i, Pack::mul(four, EI_l));
+            Pack::store(k.e + i, Pack::mul(two, EI_l));
+        }
+        return i;
+    }
+} // end anonymous namespace
+
+#endif // ELEMENTKERNELSIMD_H
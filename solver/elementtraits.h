@@ -0,0 +1,109 @@
+#ifndef ELEMENTTRAITS_H
+#define ELEMENTTRAITS_H
+
+#include "elements/elementtypes.h"
+
+// compile-time description of every kind of rod and bearing, the fcts that loop over the rods are templates over the traits and get instantiated once per kind
+// the local dofs of a rod are given per node (0: node1, 1: node2), they are the positions in the row of the coincidence-table and in the ESM
+// note: the dof-maps are constexpr fcts instead of static arrays because static constexpr arrays would need a definition in a translation-unit with c++14
+
+template<RodType type>
+struct ElementTraits;
+
+template<>
+struct ElementTraits<RodType::Beam> // y1, m1, y2, m2, x1, x2
+{
+    static constexpr RodType type = RodType::Beam;
+    static constexpr int dofCount = 6;
+    static constexpr bool hasBending = true;
+    static constexpr bool tensionOnly = false;
+    static constexpr int y(int node) { return node == 0 ? 0 : 2; }
+    static constexpr int m(int node) { return node == 0 ? 1 : 3; }
+    static constexpr int x(int node) { return node == 0 ? 4 : 5; }
+    static constexpr double bendingStiffness(double I) { return I; } // the I that goes into the ESM
+};
+
+template<>
+struct ElementTraits<RodType::Bar> // y1, y2, x1, x2
+{
+    static constexpr RodType type = RodType::Bar;
+    static constexpr int dofCount = 4;
+    static constexpr bool hasBending = false;
+    static constexpr bool tensionOnly = false;
+    static constexpr int y(int node) { return node; }
+    static constexpr int m(int) { return -1; } // no rotation-dof, the rod is hinged at both ends
+    static constexpr int x(int node) { return 2 + node; }
+    static constexpr double bendingStiffness(double) { return 0; } // then all bending-terms of the ESM vanish
+};
+
+template<>
+struct ElementTraits<RodType::Rope> // same dofs and ESM as a bar, but the rope has to be removed from the system if it gets compressed
+{
+    static constexpr RodType type = RodType::Rope;
+    static constexpr int dofCount = 4;
+    static constexpr bool hasBending = false;
+    static constexpr bool tensionOnly = true;
+    static constexpr int y(int node) { return node; }
+    static constexpr int m(int) { return -1; }
+    static constexpr int x(int node) { return 2 + node; }
+    static constexpr double bendingStiffness(double) { return 0; }
+};
+
+template<BearingType type>
+struct BearingTraits; // which dofs of the node the bearing holds, the other ones are force-free
+
+template<>
+struct BearingTraits<BearingType::LocatingBearing>
+{
+    static constexpr bool fixesY = true;
+    static constexpr bool fixesX = true;
+    static constexpr bool fixesRotation = false;
+};
+
+template<>
+struct BearingTraits<BearingType::FloatingBearing>
+{
+    static constexpr bool fixesY = true;
+    static constexpr bool fixesX = false;
+    static constexpr bool fixesRotation = false;
+};
+
+template<>
+struct BearingTraits<BearingType::FixedClamping>
+{
+    static constexpr bool fixesY = true;
+    static constexpr bool fixesX = true;
+    static constexpr bool fixesRotation = true;
+};
+
+template<typename Fct>
+void visitRodType(RodType type, Fct &&fct) // calls fct with the traits of type (fct is a generic lambda that takes the traits by value)
+{
+    switch (type) {
+    case RodType::Beam:
+        fct(ElementTraits<RodType::Beam>());
+        break;
+    case RodType::Bar:
+        fct(ElementTraits<RodType::Bar>());
+        break;
+    default:
+        fct(ElementTraits<RodType::Rope>());
+    }
+}
+
+template<typename Fct>
+void visitBearingType(BearingType type, Fct &&fct) // see visitRodType()
+{
+    switch (type) {
+    case BearingType::LocatingBearing:
+        fct(BearingTraits<BearingType::LocatingBearing>());
+        break;
+    case BearingType::FloatingBearing:
+        fct(BearingTraits<BearingType::FloatingBearing>());
+        break;
+    default:
+        fct(BearingTraits<BearingType::FixedClamping>());
+    }
+}
+
+#endif // ELEMENTTRAITS_H
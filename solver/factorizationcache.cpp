@@ -0,0 +1,149 @@
+#include "solver/factorizationcache.h"
+
+namespace
+{
+    // FNV-1a over the raw bytes of the arrays, good enough to tell models apart, a collision is caught by the exact comparison in isValidFor()
+    const quint64 fnvOffsetBasis = 14695981039346656037ULL;
+    const quint64 fnvPrime = 1099511628211ULL;
+
+    void hashBytes(quint64 &hash, const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= fnvPrime;
+        }
+    }
+
+    template<typename T>
+    void hashVector(quint64 &hash, const QVector<T> &vector)
+    {
+        int size = vector.size();
+        hashBytes(hash, &size, sizeof(size)); // so that e.g. moving a value from one array to the next one changes the hash
+        if (size > 0) {
+            hashBytes(hash, vector.constData(), sizeof(T) * static_cast<size_t>(size));
+        }
+    }
+
+    void hashVector(quint64 &hash, const QVector<bool> &vector) // bool has no guaranteed object-representation, therefore hash the values
+    {
+        int size = vector.size();
+        hashBytes(hash, &size, sizeof(size));
+        for (bool value : vector) {
+            unsigned char byte = value ? 1 : 0;
+            hashBytes(hash, &byte, 1);
+        }
+    }
+
+    TrussModel withoutLoads(const TrussModel &model)
+    {
+        TrussModel stiffness;
+        stiffness.nodeX = model.nodeX;
+        stiffness.nodeY = model.nodeY;
+        stiffness.nodeType = model.nodeType;
+        stiffness.nodeHasBearing = model.nodeHasBearing;
+        stiffness.nodeBearingType = model.nodeBearingType;
+        stiffness.rodNode1 = model.rodNode1;
+        stiffness.rodNode2 = model.rodNode2;
+        stiffness.rodE = model.rodE;
+        stiffness.rodA = model.rodA;
+        stiffness.rodI = model.rodI;
+        stiffness.rodType = model.rodType;
+        return stiffness;
+    }
+} // end anonymous namespace
+
+bool FactorizationCache::isValidFor(const TrussModel &model, const Calculator::SolverSettings &settings) const
+{
+    if (!valid || determineFingerprint(model, settings) != fingerprint) {
+        return false;
+    }
+    return model.nodeX == key.nodeX && model.nodeY == key.nodeY && model.nodeType == key.nodeType && model.nodeHasBearing == key.nodeHasBearing
+            && model.nodeBearingType == key.nodeBearingType && model.rodNode1 == key.rodNode1 && model.rodNode2 == key.rodNode2 && model.rodE == key.rodE
+            && model.rodA == key.rodA && model.rodI == key.rodI && model.rodType == key.rodType && settings.sparseAssemblyThreshold == keySettings.sparseAssemblyThreshold
+            && settings.solverBackend == keySettings.solverBackend && settings.dofOrdering == keySettings.dofOrdering
+            && Calculator::determineAnalysisType(model, settings) == analysisType; // an automatic analysis-type also depends on the applied moments
+}
+
+bool FactorizationCache::canUpdateTo(const TrussModel &model, const Calculator::SolverSettings &settings) const
+{
+    // the numbering depends on the graph of the rods, the rod- and node-types, the partition on the bearings, the positions and E, A, I only change the values of K
+    return valid && model.nodeX.size() == key.nodeX.size() && model.nodeType == key.nodeType && model.nodeHasBearing == key.nodeHasBearing
+            && model.nodeBearingType == key.nodeBearingType && model.rodNode1 == key.rodNode1 && model.rodNode2 == key.rodNode2 && model.rodType == key.rodType
+            && settings.sparseAssemblyThreshold == keySettings.sparseAssemblyThreshold && settings.solverBackend == keySettings.solverBackend
+            && settings.dofOrdering == keySettings.dofOrdering && Calculator::determineAnalysisType(model, settings) == analysisType;
+}
+
+Eigen::MatrixXd FactorizationCache::solve(const Eigen::MatrixXd &B) const
+{
+    Eigen::MatrixXd Y = solver->solve(B);
+    if (correctionDofs.isEmpty()) {
+        return Y;
+    }
+    Eigen::MatrixXd Y_c(correctionDofs.size(), Y.cols()); // P^T * Y
+    for (int i = 0; i < correctionDofs.size(); i++) {
+        Y_c.row(i) = Y.row(correctionDofs.at(i));
+    }
+    return Y - correctionZ * correctionS.solve(correctionC * Y_c);
+}
+
+void FactorizationCache::setKey(const TrussModel &model, const Calculator::SolverSettings &settings)
+{
+    fingerprint = determineFingerprint(model, settings);
+    key = withoutLoads(model); // the arrays are implicitly shared, therefore this is cheap as long as the snapshot is not modified
+    keySettings = settings;
+    valid = true;
+}
+
+void FactorizationCache::clear()
+{
+    valid = false;
+    fingerprint = 0;
+    key = TrussModel();
+    dofCount = 0;
+    analysisType = AnalysisType::Frame;
+    rodTypes.clear();
+    nodeFirstDof.clear();
+    nodeDofCount.clear();
+    coincidenceTable.clear();
+    T_es.clear();
+    system = PartitionedSystem();
+    K_ab = Eigen::SparseMatrix<double>();
+    K_ba = Eigen::SparseMatrix<double>();
+    K_bb = Eigen::SparseMatrix<double>();
+    K_aa = Eigen::SparseMatrix<double>();
+    solver.reset();
+    elementMatrices.clear();
+    factorizedElementMatrices.clear();
+    updateCount = 0;
+    correctionDofs.clear();
+    correctionC = Eigen::MatrixXd();
+    correctionZ = Eigen::MatrixXd();
+    slackRopes.clear();
+    secondOrderU = Eigen::MatrixXd();
+    modalDensities.clear();
+    modalMassMatrix = MassMatrix::Consistent;
+    modalModeCount = 0;
+    naturalFrequencies = Eigen::VectorXd();
+    naturalModes = Eigen::MatrixXd();
+}
+
+quint64 FactorizationCache::determineFingerprint(const TrussModel &model, const Calculator::SolverSettings &settings)
+{
+    quint64 hash = fnvOffsetBasis;
+    hashVector(hash, model.nodeX);
+    hashVector(hash, model.nodeY);
+    hashVector(hash, model.nodeType);
+    hashVector(hash, model.nodeHasBearing);
+    hashVector(hash, model.nodeBearingType);
+    hashVector(hash, model.rodNode1);
+    hashVector(hash, model.rodNode2);
+    hashVector(hash, model.rodE);
+    hashVector(hash, model.rodA);
+    hashVector(hash, model.rodI);
+    hashVector(hash, model.rodType);
+    int settingValues[4] = {settings.sparseAssemblyThreshold, static_cast<int>(settings.solverBackend), static_cast<int>(settings.dofOrdering),
+                            static_cast<int>(settings.analysisType)};
+    hashBytes(hash, settingValues, sizeof(settingValues));
+    return hash;
+}
@@ -0,0 +1,81 @@
+#ifndef FACTORIZATIONCACHE_H
+#define FACTORIZATIONCACHE_H
+
+#include "calculator.h"
+#include "solver/linearsolver.h"
+#include "solver/partitionedsystem.h"
+
+#include <memory>
+
+// keeps the load-independent part of the last solved system (numbering, transformation-matrices, partition, blocks and the factorization of K_aa)
+// a model that only differs in its loads is then solved with one forward/back-substitution instead of assembling and factorizing K again
+// the cache is keyed on a fingerprint of everything the stiffness depends on: node-positions, connectivity, E/A/I, rod- and node-types, bearings, the solver-settings and the analysis-type
+// if only node-positions or rod-properties changed (e.g. while a node gets dragged), the factorization is kept and corrected by the changed element-matrices (see Calculator::updateFactorization())
+// it is not thread-safe, every thread that solves needs its own cache
+class FactorizationCache
+{
+public:
+    explicit FactorizationCache() = default;
+    // holds a LinearSolver, therefore disable copying/moving
+    FactorizationCache(const FactorizationCache &) = delete;
+    FactorizationCache(FactorizationCache &&) = delete;
+    FactorizationCache &operator =(const FactorizationCache &) = delete;
+    FactorizationCache &operator =(FactorizationCache &&) = delete;
+
+    bool isValidFor(const TrussModel &model, const Calculator::SolverSettings &settings) const; // true if the cached factorization can be used to solve model
+    bool canUpdateTo(const TrussModel &model, const Calculator::SolverSettings &settings) const; // true if model has the same numbering and partition, only the values of K differ
+    void setKey(const TrussModel &model, const Calculator::SolverSettings &settings); // call this after the members below were filled for model
+    void clear(); // invalidates the cache and frees the factorization
+
+    Eigen::MatrixXd solve(const Eigen::MatrixXd &B) const; // returns X of K_aa * X = B, including the low-rank correction
+
+    static quint64 determineFingerprint(const TrussModel &model, const Calculator::SolverSettings &settings); // loads are ignored
+
+    // load-independent part of the solution, filled by Calculator::factorizeSystem()
+    int dofCount = 0;
+    AnalysisType analysisType = AnalysisType::Frame; // resolved, never Automatic
+    QVector<RodType> rodTypes; // see Calculator::determineRodTypes()
+    QVector<int> nodeFirstDof;
+    QVector<int> nodeDofCount;
+    QVector<QVector<int>> coincidenceTable;
+    QVector<Eigen::Matrix6d> T_es;
+    DofOrdering usedOrdering = DofOrdering::Natural;
+    OrderingMetrics naturalMetrics;
+    OrderingMetrics metrics;
+    int usedThreadCount = 1; // threads the ESMs were computed and K was assembled with
+    double esmMilliseconds = 0; // wall-clock time of determineESM() in the last factorization
+    double assemblyMilliseconds = 0; // wall-clock time of the assembly of K in the last factorization
+    PartitionedSystem system;
+    Eigen::SparseMatrix<double> K_ab; // the blocks are stored sparse even if K was assembled dense, they are only needed for matrix-vector-products
+    Eigen::SparseMatrix<double> K_ba;
+    Eigen::SparseMatrix<double> K_bb;
+    Eigen::SparseMatrix<double> K_aa; // current K_aa, only needed to check the accuracy of the low-rank correction
+    std::unique_ptr<LinearSolver> solver; // holds the factorization of K_aa (as it was when it was factorized)
+    QVector<Calculator::ElementMatrix> elementMatrices; // ESMs in global coords of the current model
+    QVector<Calculator::ElementMatrix> factorizedElementMatrices; // ESMs of the model whose K_aa is factorized
+
+    // low-rank correction (sherman-morrison-woodbury): K_aa = K_aa,factorized + P * C * P^T, P selects the free dofs of the rods that changed since the factorization
+    // K_aa^-1 * B = Y - Z * S^-1 * C * P^T * Y with Y = K_aa,factorized^-1 * B, Z = K_aa,factorized^-1 * P and S = I + C * P^T * Z
+    int updateCount = 0; // low-rank updates since the last factorization
+    QVector<int> correctionDofs; // local indices (in U_a) of the dofs selected by P, empty if there is no correction
+    Eigen::MatrixXd correctionC;
+    Eigen::MatrixXd correctionZ;
+    Eigen::PartialPivLU<Eigen::MatrixXd> correctionS;
+
+    QVector<QVector<int>> slackRopes; // slack ropes of every column of the last solve(), the first guess of the active-set iteration of the next one
+    Eigen::MatrixXd secondOrderU; // converged displacements of every column of the last second-order solve(), the warm start of the next one (see solver/nonlinear.h)
+    // modal analysis of the last solve(), it does not depend on the loads and is reused as long as the factorization is and the masses and mode-count stay the same
+    QVector<double> modalDensities;
+    MassMatrix modalMassMatrix = MassMatrix::Consistent;
+    int modalModeCount = 0; // 0: no modes cached
+    Eigen::VectorXd naturalFrequencies;
+    Eigen::MatrixXd naturalModes;
+
+private:
+    bool valid = false;
+    quint64 fingerprint = 0;
+    TrussModel key; // copy of the stiffness-relevant arrays (without loads), compared exactly if the fingerprints match
+    Calculator::SolverSettings keySettings;
+};
+
+#endif // FACTORIZATIONCACHE_H
@@ -0,0 +1,144 @@
+#include "solver/lanczos.h"
+
+#include "solver/factorizationcache.h"
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+    // a ritz-pair (mu, phi) has converged if the K-norm of K^-1 * B * phi - mu * phi is below this fraction of |mu|, the error of mu is about the square of it
+    const double ritzTolerance = 1e-8;
+    // the basis holds up to 2 * count + this many lanczos-vectors, a restart keeps the wanted ritz-vectors and half of the others
+    const int extraVectors = 20;
+    const int maxRestarts = 100;
+    // a new lanczos-vector that is shorter than this fraction of K^-1 * B * q is only the round-off of the solve (K can be badly conditioned, e.g. EA >> EI / l^2)
+    const double breakdownRatio = 1e-8;
+} // end anonymous namespace
+
+bool Lanczos::solve(const Eigen::SparseMatrix<double> &K_aa, const Eigen::SparseMatrix<double> &B_aa, const std::function<Eigen::VectorXd(const Eigen::VectorXd &)> &applyInverse,
+                    int count, Eigen::VectorXd &mu, Eigen::MatrixXd &phi_a)
+{
+    int n = K_aa.rows();
+    mu = Eigen::VectorXd();
+    phi_a = Eigen::MatrixXd(n, 0);
+    if (count <= 0 || n == 0) {
+        return true;
+    }
+
+    // Q^T * K * Q = I, the products K * q are kept (KQ) for the reorthogonalization
+    // K * q is multiplied out instead of being carried along the recurrence, the round-off of the solves would otherwise destroy the K-orthogonality once the
+    // krylov-space has exhausted the range of B (e.g. K_G has a rank of at most the transverse dofs, a lumped M has no rotational mass)
+    int maxVectors = qMin(n, 2 * count + extraVectors);
+    Eigen::MatrixXd Q(n, maxVectors);
+    Eigen::MatrixXd KQ(n, maxVectors);
+    Eigen::MatrixXd T = Eigen::MatrixXd::Zero(maxVectors, maxVectors); // Q^T * B * Q, tridiagonal apart from the rows of the kept ritz-vectors after a restart
+    // the start-vectors are taken from the range of K^-1 * B, the dofs in the null-space of B (mu = 0) would only slow down the convergence
+    std::mt19937 generator(1); // fixed seed, solving the same model twice gives the same modes
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    Eigen::VectorXd x(n), q, Kq;
+    auto newStartVector = [&](int basisSize) -> bool { // K-normalized and K-orthogonal to the basis, false if the basis already spans the range
+        for (int i = 0; i < n; i++) {
+            x(i) = distribution(generator);
+        }
+        q = applyInverse(B_aa * x);
+        double initialNorm = sqrt(fmax(q.dot(K_aa * q), 0));
+        for (int pass = 0; pass < 2; pass++) {
+            q -= Q.leftCols(basisSize) * (KQ.leftCols(basisSize).transpose() * q);
+        }
+        Kq = K_aa * q;
+        double norm = sqrt(fmax(q.dot(Kq), 0));
+        if (!(norm > breakdownRatio * initialNorm)) { // also if B is 0
+            return false;
+        }
+        q /= norm;
+        Kq /= norm;
+        return true;
+    };
+    if (!newStartVector(0)) {
+        return true;
+    }
+    int j = 0; // vectors in the basis
+    for (int restart = 0;; restart++) {
+        double beta = 0;
+        bool exhausted = false; // the basis spans an invariant subspace, its ritz-pairs are exact
+        while (j < maxVectors) {
+            Q.col(j) = q;
+            KQ.col(j) = Kq;
+            Eigen::VectorXd Bq = B_aa * q;
+            Eigen::VectorXd w = applyInverse(Bq); // w = K^-1 * B * q
+            double wNorm = sqrt(fmax(w.dot(Bq), 0)); // K-norm of w before the orthogonalization (if B is indefinite only a scale for the breakdown)
+            Eigen::VectorXd h = Q.leftCols(j + 1).transpose() * Bq; // Q^T * K * w, exact because K * w = B * q
+            w -= Q.leftCols(j + 1) * h;
+            Eigen::VectorXd correction = KQ.leftCols(j + 1).transpose() * w; // full reorthogonalization, gram-schmidt a second time
+            w -= Q.leftCols(j + 1) * correction;
+            T.block(0, j, j + 1, 1) = h;
+            T.block(j, 0, 1, j + 1) = h.transpose();
+            j++;
+            Eigen::VectorXd Kw = K_aa * w;
+            beta = sqrt(fmax(w.dot(Kw), 0));
+            if (beta <= breakdownRatio * wNorm) { // what is left of w is round-off, the basis spans an invariant subspace
+                // a krylov-space holds only one vector per distinct mu, the second mode of a symmetric structure needs another start-vector
+                if (j < maxVectors && newStartVector(j)) {
+                    continue;
+                }
+                exhausted = true;
+                break;
+            }
+            q = w / beta;
+            Kq = Kw / beta;
+        }
+        exhausted = exhausted || j == n;
+
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigenSolver(T.topLeftCorner(j, j)); // small and dense, one row per lanczos-vector
+        const Eigen::VectorXd &ritzValues = eigenSolver.eigenvalues(); // ascending, therefore the wanted ones are at the end
+        const Eigen::MatrixXd &S = eigenSolver.eigenvectors();
+        double muLimit = ritzTolerance * ritzValues.cwiseAbs().maxCoeff(); // the null-space of B gives mu = 0 up to round-off
+        int wanted = 0;
+        while (wanted < qMin(count, j) && ritzValues(j - 1 - wanted) > muLimit) {
+            wanted++;
+        }
+        bool converged = true;
+        for (int i = j - wanted; i < j && !exhausted; i++) {
+            converged = converged && beta * fabs(S(j - 1, i)) <= ritzTolerance * fabs(ritzValues(i)); // residual of the ritz-pair, q is K-normalized
+        }
+        if (converged) {
+            mu = ritzValues.tail(wanted).reverse();
+            phi_a = Q.leftCols(j) * S.rightCols(wanted).rowwise().reverse();
+            return true;
+        }
+        if (restart == maxRestarts) {
+            return false;
+        }
+        // thick restart: the basis is replaced by the largest ritz-vectors, q stays the next vector (it is K-orthogonal to all of them)
+        int kept = qMin(j - 1, wanted + (maxVectors - wanted) / 2);
+        Q.leftCols(kept) = Eigen::MatrixXd(Q.leftCols(j) * S.rightCols(kept));
+        KQ.leftCols(kept) = Eigen::MatrixXd(KQ.leftCols(j) * S.rightCols(kept));
+        T.setZero();
+        T.diagonal().head(kept) = ritzValues.tail(kept);
+        j = kept;
+    }
+}
+
+void Lanczos::scatterModes(const FactorizationCache &factorization, const Eigen::MatrixXd &phi_a, Eigen::MatrixXd &modes)
+{
+    const QVector<int> &freeDofs = factorization.system.getFreeDofs();
+    modes = Eigen::MatrixXd::Zero(factorization.dofCount, phi_a.cols()); // the prescribed dofs stay 0
+    for (int i = 0; i < phi_a.cols(); i++) {
+        for (int a = 0; a < freeDofs.size(); a++) {
+            modes(freeDofs.at(a), i) = phi_a(a, i);
+        }
+        double largest = 0;
+        for (int node = 0; node < factorization.nodeFirstDof.size(); node++) {
+            int first = factorization.nodeFirstDof.at(node);
+            for (int dof = first; dof < first + qMin(2, factorization.nodeDofCount.at(node)); dof++) { // y and x, the rotations have another unit
+                if (fabs(modes(dof, i)) > fabs(largest)) {
+                    largest = modes(dof, i);
+                }
+            }
+        }
+        if (largest != 0) {
+            modes.col(i) /= largest;
+        }
+    }
+}
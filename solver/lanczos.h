@@ -0,0 +1,26 @@
+#ifndef LANCZOS_H
+#define LANCZOS_H
+
+#include "libs/Eigen/Eigen/Eigen"
+
+#include <functional>
+
+class FactorizationCache;
+
+// symmetric eigenproblems B * phi = mu * K * phi of the free dofs, K_aa positive definite and already factorized, B_aa symmetric (K_G for buckling, M for the vibrations)
+// lanczos runs on K^-1 * B, which is symmetric in the K-inner-product, with the shift 0 (shift-invert), therefore every iteration only needs one solve with the cached
+// factorization and sparse products with K_aa and B_aa, the largest mu (the smallest load-factors resp. natural frequencies) converge first
+// the basis is fully reorthogonalized, it gets a new start-vector if it spans an invariant subspace (repeated mu) and is restarted with the wanted ritz-vectors (thick restart)
+// if it is full before they converged
+namespace Lanczos
+{
+    // mu gets the largest positive eigenvalues in descending order (fewer than count if B has fewer positive ones), phi_a the eigenvectors (one column per mu, K-normalized)
+    // applyInverse returns K_aa^-1 * b, K_aa is multiplied out to keep the basis K-orthogonal, returns false if the wanted pairs did not converge
+    bool solve(const Eigen::SparseMatrix<double> &K_aa, const Eigen::SparseMatrix<double> &B_aa, const std::function<Eigen::VectorXd(const Eigen::VectorXd &)> &applyInverse,
+               int count, Eigen::VectorXd &mu, Eigen::MatrixXd &phi_a);
+
+    // modes gets one column per column of phi_a with an entry for every dof (0 at the prescribed dofs), scaled so that the largest displacement is 1
+    void scatterModes(const FactorizationCache &factorization, const Eigen::MatrixXd &phi_a, Eigen::MatrixXd &modes);
+}
+
+#endif // LANCZOS_H
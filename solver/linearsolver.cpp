@@ -0,0 +1,132 @@
+#include "linearsolver.h"
+
+LinearSolver::LinearSolver(SolverBackend backend, bool keepOrdering) :
+    requestedBackend(backend),
+    usedBackend(backend),
+    keepOrdering(keepOrdering),
+    singular(false)
+{
+}
+
+void LinearSolver::factorize(const Eigen::SparseMatrix<double> &A)
+{
+    singular = false;
+    usedBackend = requestedBackend == SolverBackend::Automatic ? SolverBackend::SparseLDLT : requestedBackend;
+    if (A.rows() != A.cols()) { // only square matrices can be decomposed by the cholesky-variants
+        factorizeCOD(A.toDense());
+        return;
+    }
+    switch (usedBackend) {
+    case SolverBackend::SparseLDLT:
+        if (keepOrdering ? factorizeSparseLDLT(orderedSparseLDLT, A) : factorizeSparseLDLT(sparseLDLT, A)) {
+            return;
+        }
+        break;
+    case SolverBackend::SparseLLT:
+        if (keepOrdering ? factorizeSparseLLT(orderedSparseLLT, A) : factorizeSparseLLT(sparseLLT, A)) {
+            return;
+        }
+        break;
+    case SolverBackend::DenseLDLT:
+        factorize(A.toDense()); // forward to dense version
+        return;
+    default: // SolverBackend::DenseCOD
+        break;
+    }
+    factorizeCOD(A.toDense()); // A is singular (or the requested backend is the pseudo-inverse)
+}
+
+void LinearSolver::factorize(const Eigen::MatrixXd &A)
+{
+    singular = false;
+    usedBackend = requestedBackend == SolverBackend::Automatic ? SolverBackend::DenseLDLT : requestedBackend;
+    if (A.rows() != A.cols()) {
+        factorizeCOD(A);
+        return;
+    }
+    switch (usedBackend) {
+    case SolverBackend::SparseLDLT:
+    case SolverBackend::SparseLLT:
+        factorize(Eigen::SparseMatrix<double>(A.sparseView())); // forward to sparse version
+        return;
+    case SolverBackend::DenseLDLT:
+        denseLDLT.compute(A);
+        if (denseLDLT.info() == Eigen::Success && isRegular(denseLDLT.vectorD())) {
+            return;
+        }
+        break;
+    default: // SolverBackend::DenseCOD
+        break;
+    }
+    factorizeCOD(A);
+}
+
+Eigen::MatrixXd LinearSolver::solve(const Eigen::MatrixXd &B) const
+{
+    switch (usedBackend) { // every column of B is solved with the same factorization
+    case SolverBackend::SparseLDLT:
+        if (keepOrdering) {
+            return orderedSparseLDLT.solve(B);
+        }
+        return sparseLDLT.solve(B);
+    case SolverBackend::SparseLLT:
+        if (keepOrdering) {
+            return orderedSparseLLT.solve(B);
+        }
+        return sparseLLT.solve(B);
+    case SolverBackend::DenseLDLT:
+        return denseLDLT.solve(B);
+    default:
+        return cod.solve(B);
+    }
+}
+
+QString LinearSolver::toString(SolverBackend backend)
+{
+    switch (backend) {
+    case SolverBackend::Automatic:
+        return "Automatisch";
+    case SolverBackend::SparseLDLT:
+        return "Sparse LDLT";
+    case SolverBackend::SparseLLT:
+        return "Sparse LLT";
+    case SolverBackend::DenseLDLT:
+        return "Dichte LDLT";
+    default:
+        return "Pseudoinverse (COD)";
+    }
+}
+
+bool LinearSolver::isRegular(const Eigen::VectorXd &pivots) const
+{
+    if (pivots.size() == 0) {
+        return true;
+    }
+    // a stiffness-matrix is positive semi-definite, therefore negative or vanishing pivots indicate a kinematic system (the tolerance is relative to the stiffest dof)
+    return pivots.allFinite() && pivots.minCoeff() > 1e-10 * pivots.cwiseAbs().maxCoeff();
+}
+
+void LinearSolver::factorizeCOD(const Eigen::MatrixXd &A)
+{
+    usedBackend = SolverBackend::DenseCOD;
+    singular = requestedBackend != SolverBackend::DenseCOD; // only mark the system as singular if the pseudo-inverse was not requested explicitly
+    cod.compute(A);
+}
+
+template<typename Decomposition>
+bool LinearSolver::factorizeSparseLDLT(Decomposition &decomposition, const Eigen::SparseMatrix<double> &A)
+{
+    decomposition.compute(A);
+    return decomposition.info() == Eigen::Success && isRegular(decomposition.vectorD());
+}
+
+template<typename Decomposition>
+bool LinearSolver::factorizeSparseLLT(Decomposition &decomposition, const Eigen::SparseMatrix<double> &A)
+{
+    decomposition.compute(A);
+    if (decomposition.info() != Eigen::Success) {
+        return false;
+    }
+    Eigen::VectorXd diagonalL = decomposition.matrixL().nestedExpression().diagonal(); // the pivots of the LDLT-decomposition are the squared diagonal entries of L
+    return isRegular(diagonalL.cwiseAbs2());
+}
@@ -0,0 +1,56 @@
+#ifndef LINEARSOLVER_H
+#define LINEARSOLVER_H
+
+#include "libs/Eigen/Eigen/Eigen"
+
+#include <QString>
+
+enum class SolverBackend : int {
+    Automatic = 0, // dense LDLT for dense assembled systems, sparse LDLT for sparse assembled systems
+    SparseLDLT = 1,
+    SparseLLT = 2,
+    DenseLDLT = 3,
+    DenseCOD = 4 // pseudo-inverse, only needed for singular (kinematic) systems
+};
+
+class LinearSolver
+{
+public:
+    explicit LinearSolver(SolverBackend backend = SolverBackend::Automatic, bool keepOrdering = false); // keepOrdering: the sparse backends factorize A in the given order instead of applying AMD
+    // the decompositions are not meant to be copied around (they can be huge), therefore disable copying/moving
+    LinearSolver(const LinearSolver &) = delete;
+    LinearSolver(LinearSolver &&) = delete;
+    LinearSolver &operator =(const LinearSolver &) = delete;
+    LinearSolver &operator =(LinearSolver &&) = delete;
+
+    void factorize(const Eigen::SparseMatrix<double> &A); // factorizes A with the requested backend, falls back to the pseudo-inverse if A is singular
+    void factorize(const Eigen::MatrixXd &A); // see above
+    Eigen::MatrixXd solve(const Eigen::MatrixXd &B) const; // returns X of A * X = B (one column per right-hand-side), factorize() has to be called beforehand
+
+    SolverBackend getRequestedBackend() const { return requestedBackend; }
+    SolverBackend getUsedBackend() const { return usedBackend; } // the backend that actually solves the system (differs from the requested one after a fallback)
+    bool isSingular() const { return singular; }
+
+    static QString toString(SolverBackend backend);
+
+private:
+    bool isRegular(const Eigen::VectorXd &pivots) const; // checks if all pivots are positive and not negligibly small compared to the biggest one
+    void factorizeCOD(const Eigen::MatrixXd &A);
+    template<typename Decomposition>
+    bool factorizeSparseLDLT(Decomposition &decomposition, const Eigen::SparseMatrix<double> &A); // returns false if A is singular
+    template<typename Decomposition>
+    bool factorizeSparseLLT(Decomposition &decomposition, const Eigen::SparseMatrix<double> &A);
+
+    SolverBackend requestedBackend;
+    SolverBackend usedBackend;
+    bool keepOrdering;
+    bool singular;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> sparseLDLT; // uses a fill-reducing (AMD) ordering
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> sparseLLT;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower, Eigen::NaturalOrdering<int>> orderedSparseLDLT; // used if the dofs are already reordered
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>, Eigen::Lower, Eigen::NaturalOrdering<int>> orderedSparseLLT;
+    Eigen::LDLT<Eigen::MatrixXd> denseLDLT;
+    Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd> cod;
+};
+
+#endif // LINEARSOLVER_H
@@ -0,0 +1,161 @@
+#include "solver/loadcombination.h"
+
+#include <QRegularExpression>
+
+namespace
+{
+    // the combined results are computed block by block, so that hundreds of combinations of a large system do not need dofCount x combinationCount doubles at once
+    const int combinationsPerBlock = 64;
+
+    void updateEnvelope(const Eigen::MatrixXd &results, bool firstBlock, Eigen::VectorXd &minValues, Eigen::VectorXd &maxValues)
+    {
+        if (firstBlock) {
+            minValues = results.rowwise().minCoeff();
+            maxValues = results.rowwise().maxCoeff();
+        } else {
+            minValues = minValues.cwiseMin(results.rowwise().minCoeff());
+            maxValues = maxValues.cwiseMax(results.rowwise().maxCoeff());
+        }
+    }
+
+    // the text of a factor that parse() reads back as exactly the same double, short for the usual factors like 1.35 (QString::number() rounds to 6 digits)
+    QString formatFactor(double factor)
+    {
+        QString text = QString::number(factor, 'g', 15);
+        return text.toDouble() == factor ? text : QString::number(factor, 'g', 17);
+    }
+
+    // splits in front of the "+" and "-" between the terms, every term starts with its sign (except a first one without), e.g. "G - 0.5 * Q" gives "G " and "- 0.5 * Q"
+    // not split are the sign of an exponent ("1e-3 * G"), the sign of a factor right after the one of its term ("G + -0.5 * Q") and the "-" of a load-case like "Wind-X"
+    QStringList splitTerms(const QString &sum, const QStringList &loadCaseNames)
+    {
+        static const QRegularExpression mantissaExpression(R"(^\s*(?:[-+]\s*)?[-+]?(?:\d+(?:[.,]\d*)?|[.,]\d+)[eE]$)");
+        static const QRegularExpression signExpression(R"(^\s*[-+]?\s*$)"); // nothing but the sign of the term so far
+        auto isInName = [&](int i) {
+            for (const QString &name : loadCaseNames) {
+                for (int k = name.indexOf('-'); k != -1; k = name.indexOf('-', k + 1)) {
+                    if (i - k >= 0 && sum.mid(i - k, name.size()) == name) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        };
+        QStringList terms;
+        QString term;
+        for (int i = 0; i < sum.size(); i++) {
+            QChar c = sum.at(i);
+            bool isSign = c == '+' || c == '-';
+            bool isNumberSign = isSign && i + 1 < sum.size() && (sum.at(i + 1).isDigit() || sum.at(i + 1) == '.' || sum.at(i + 1) == ',');
+            if (isSign && !(isNumberSign && (mantissaExpression.match(term).hasMatch() || signExpression.match(term).hasMatch())) && !(c == '-' && isInName(i))) {
+                terms.append(term);
+                term = c;
+            } else {
+                term += c;
+            }
+        }
+        terms.append(term);
+        return terms;
+    }
+} // end anonymous namespace
+
+Eigen::MatrixXd Combination::determineFactors(const TrussModel &model)
+{
+    Eigen::MatrixXd factors = Eigen::MatrixXd::Zero(model.getLoadCaseCount(), model.loadCombinations.size());
+    for (int c = 0; c < model.loadCombinations.size(); c++) {
+        const QVector<double> &combinationFactors = model.loadCombinations.at(c).factors;
+        for (int loadCase = 0; loadCase < qMin(combinationFactors.size(), model.getLoadCaseCount()); loadCase++) {
+            factors(loadCase, c) = combinationFactors.at(loadCase);
+        }
+    }
+    return factors;
+}
+
+void Combination::combine(const Calculator::Solution &solution, const Eigen::VectorXd &factors, Eigen::VectorXd &U, Eigen::VectorXd &F, Eigen::VectorXd &innerForces)
+{
+    U = solution.U * factors;
+    F = solution.F * factors;
+    innerForces = solution.innerForces * factors;
+}
+
+Calculator::Envelope Combination::determineEnvelope(const Calculator::Solution &solution, const Eigen::MatrixXd &factors)
+{
+    Calculator::Envelope envelope;
+    if (factors.cols() > 0 && solution.combinationU.cols() == factors.cols()) { // the combinations were solved (model with ropes or second-order analysis), see Calculator::solve()
+        updateEnvelope(solution.combinationU, true, envelope.minU, envelope.maxU);
+        updateEnvelope(solution.combinationF, true, envelope.minF, envelope.maxF);
+        updateEnvelope(solution.combinationInnerForces, true, envelope.minInnerForces, envelope.maxInnerForces);
+        return envelope;
+    }
+    for (int first = 0; first < factors.cols(); first += combinationsPerBlock) {
+        int count = qMin(combinationsPerBlock, static_cast<int>(factors.cols()) - first);
+        const auto block = factors.middleCols(first, count);
+        // every product is one gemm over all load-cases, the column c holds the results of the combination first + c
+        updateEnvelope(solution.U * block, first == 0, envelope.minU, envelope.maxU);
+        updateEnvelope(solution.F * block, first == 0, envelope.minF, envelope.maxF);
+        updateEnvelope(solution.innerForces * block, first == 0, envelope.minInnerForces, envelope.maxInnerForces);
+    }
+    return envelope;
+}
+
+QString Combination::parse(const QString &text, const QStringList &loadCaseNames, LoadCombination &combination)
+{
+    // format: name = [factor *] load-case + [factor *] load-case - ..., a missing factor is 1, a negative factor can be written as "- 0.5 * Q" or "+ -0.5 * Q"
+    int equals = text.indexOf('=');
+    if (equals == -1) {
+        return "missing \"=\" between the name and the load-cases";
+    }
+    combination.name = text.left(equals).trimmed();
+    if (combination.name.isEmpty()) {
+        return "the combination has no name";
+    }
+    combination.factors = QVector<double>(loadCaseNames.size(), 0);
+    static const QRegularExpression factorExpression(R"(^([-+]?(?:\d+(?:[.,]\d*)?|[.,]\d+)(?:[eE][-+]?\d+)?)\s*[*·]\s*(.+)$)");
+    bool hasTerm = false;
+    for (QString term : splitTerms(text.mid(equals + 1), loadCaseNames)) {
+        term = term.trimmed();
+        double sign = 1;
+        bool hasSign = term.startsWith('+') || term.startsWith('-');
+        if (hasSign) {
+            sign = term.startsWith('-') ? -1 : 1;
+            term = term.mid(1).trimmed();
+        }
+        if (term.isEmpty()) {
+            if (hasTerm || hasSign) { // e.g. "G + + Q" or "G -"
+                return "empty summand in " + combination.name;
+            }
+            continue; // only whitespace in front of a first term with a sign, e.g. "K = -Q"
+        }
+        double factor = 1;
+        QString loadCase = term;
+        auto match = factorExpression.match(term);
+        if (match.hasMatch()) {
+            factor = match.captured(1).replace(',', '.').toDouble();
+            loadCase = match.captured(2).trimmed();
+        }
+        int index = loadCaseNames.indexOf(loadCase);
+        if (index == -1) {
+            return "unknown load-case \"" + loadCase + "\" in " + combination.name;
+        }
+        combination.factors[index] += sign * factor; // a load-case that occurs twice gets the sum of its factors
+        hasTerm = true;
+    }
+    if (!hasTerm) {
+        return "the combination " + combination.name + " contains no load-case";
+    }
+    return "";
+}
+
+QString Combination::toString(const LoadCombination &combination, const QStringList &loadCaseNames)
+{
+    QStringList terms;
+    for (int loadCase = 0; loadCase < qMin(combination.factors.size(), loadCaseNames.size()); loadCase++) {
+        if (combination.factors.at(loadCase) != 0) {
+            terms.append(formatFactor(combination.factors.at(loadCase)) + " * " + loadCaseNames.at(loadCase));
+        }
+    }
+    if (terms.isEmpty() && !loadCaseNames.isEmpty()) { // parse() needs at least one load-case
+        terms.append("0 * " + loadCaseNames.first());
+    }
+    return combination.name + " = " + terms.join(" + ");
+}
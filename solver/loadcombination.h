@@ -0,0 +1,24 @@
+#ifndef LOADCOMBINATION_H
+#define LOADCOMBINATION_H
+
+#include "calculator.h"
+
+#include <QString>
+#include <QStringList>
+
+// the results are linear in the loads, therefore a load-combination is the linear combination of the results of its load-cases and no combination has to be solved
+// (except for models with ropes, a rope can go slack, and second-order analyses, there the combinations are solved in Calculator::solve() and the envelope is taken from their results)
+// all combinations are evaluated at once as matrix-products of the results (one column per load-case) with the factors (one column per combination)
+namespace Combination
+{
+    Eigen::MatrixXd determineFactors(const TrussModel &model); // rows: load-cases, cols: load-combinations of the model
+
+    // results of a single combination, factors holds one entry per load-case
+    void combine(const Calculator::Solution &solution, const Eigen::VectorXd &factors, Eigen::VectorXd &U, Eigen::VectorXd &F, Eigen::VectorXd &innerForces);
+    Calculator::Envelope determineEnvelope(const Calculator::Solution &solution, const Eigen::MatrixXd &factors); // empty if factors has no columns
+
+    QString parse(const QString &text, const QStringList &loadCaseNames, LoadCombination &combination); // e.g. "ULS = 1.35 * G + 1.5 * Q", returns an error-message if the text is invalid
+    QString toString(const LoadCombination &combination, const QStringList &loadCaseNames); // the inverse of parse()
+}
+
+#endif // LOADCOMBINATION_H
@@ -0,0 +1,127 @@
+#include "solver/modal.h"
+
+#include "solver/elementtraits.h"
+#include "solver/factorizationcache.h"
+#include "solver/lanczos.h"
+#include "solver/parallelrange.h"
+#include "solver/partitionedsystem.h"
+
+#include <cmath>
+
+namespace
+{
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, 6, 6> LocalMatrix;
+
+    template<typename Traits>
+    void determineRodMass(const TrussModel &model, int e, MassMatrix massMatrix, Calculator::ElementMatrix &m_e)
+    {
+        double l = model.getRodLength(e);
+        double m = model.rodRho.at(e) * model.rodA.at(e) * l; // [kg]
+        m_e = Calculator::ElementMatrix::Zero(Traits::dofCount, Traits::dofCount);
+        if (massMatrix == MassMatrix::Lumped) { // half of the mass at each node, no rotational inertia
+            for (int n = 0; n < 2; n++) {
+                m_e(Traits::y(n), Traits::y(n)) = m / 2;
+                m_e(Traits::x(n), Traits::x(n)) = m / 2;
+            }
+            return;
+        }
+        if (!Traits::hasBending) { // linear displacements in both directions, the matrix does not depend on the direction of the rod
+            for (int n1 = 0; n1 < 2; n1++) {
+                for (int n2 = 0; n2 < 2; n2++) {
+                    m_e(Traits::y(n1), Traits::y(n2)) = (n1 == n2 ? 2 : 1) * m / 6;
+                    m_e(Traits::x(n1), Traits::x(n2)) = (n1 == n2 ? 2 : 1) * m / 6;
+                }
+            }
+            return;
+        }
+        // local dofs u1, w1, r1, u2, w2, r2: u along the chord (linear), w perpendicular to it (cubic, counterclockwise in the right-handed frame like in solver/buckling.cpp)
+        double angle = model.getRodAngle(e);
+        double c = cos(angle);
+        double s = sin(angle);
+        LocalMatrix L = LocalMatrix::Zero(6, Traits::dofCount);
+        for (int n = 0; n < 2; n++) {
+            L(3 * n, Traits::x(n)) = c; // u = c * x - s * y, like in Calculator::determineInnerForces()
+            L(3 * n, Traits::y(n)) = - s;
+            L(3 * n + 1, Traits::x(n)) = - s; // w = - s * x - c * y
+            L(3 * n + 1, Traits::y(n)) = - c;
+            L(3 * n + 2, Traits::m(n)) = 1;
+        }
+        LocalMatrix m_local(6, 6);
+        m_local << 140, 0, 0, 70, 0, 0,
+                   0, 156, 22 * l, 0, 54, -13 * l,
+                   0, 22 * l, 4 * l * l, 0, 13 * l, -3 * l * l,
+                   70, 0, 0, 140, 0, 0,
+                   0, 54, 13 * l, 0, 156, -22 * l,
+                   0, -13 * l, -3 * l * l, 0, -22 * l, 4 * l * l;
+        m_local *= m / 420;
+        m_e = L.transpose() * m_local * L;
+    }
+} // end anonymous namespace
+
+void Modal::determineMassESM(const TrussModel &model, RodType type, int e, MassMatrix massMatrix, Calculator::ElementMatrix &m_e)
+{
+    visitRodType(type, [&](auto traits) {
+        determineRodMass<decltype(traits)>(model, e, massMatrix, m_e);
+    });
+}
+
+QString Modal::assembleMassMatrix(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization,
+                                  Eigen::SparseMatrix<double> &M_aa)
+{
+    int rodCount = model.getRodCount();
+    // M is always assembled sparse like K_G, it is only needed for matrix-vector-products
+    QVector<Calculator::ElementMatrix> m_es(rodCount);
+    Calculator::ElementMatrix *m_e = m_es.data(); // detach here and not on the threads
+    int rangeCount = Parallel::determineRangeCount(rodCount, Parallel::determineThreadCount(settings.threadCount), Parallel::minRodsPerThread);
+    Parallel::forEachRange(rodCount, rangeCount, [&](int, int begin, int end) {
+        for (int e = begin; e < end; e++) {
+            determineMassESM(model, factorization.rodTypes.at(e), e, settings.massMatrix, m_e[e]);
+        }
+    });
+    Eigen::SparseMatrix<double> M, M_ab, M_ba, M_bb;
+    auto status = Calculator::assembleSparseGSM(factorization.dofCount, rodCount, factorization.coincidenceTable, m_es, settings.threadCount, M);
+    if (status != "") {
+        return status;
+    }
+    factorization.system.extractBlocks(M, M_aa, M_ab, M_ba, M_bb);
+    return "";
+}
+
+QString Modal::solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, Eigen::VectorXd &frequencies,
+                     Eigen::MatrixXd &modes, int &iterations)
+{
+    frequencies = Eigen::VectorXd();
+    modes = Eigen::MatrixXd();
+    iterations = 0;
+    const PartitionedSystem &system = factorization.system;
+    if (settings.naturalModes <= 0 || system.getFreeDofs().isEmpty()) {
+        return "";
+    }
+    if (factorization.solver == nullptr || factorization.solver->isSingular()) {
+        return "the modal analysis needs a stable system, the stiffness-matrix is singular";
+    }
+    for (int e = 0; e < model.getRodCount(); e++) { // a negative mass gives imaginary frequencies, a system without mass infinite ones
+        if (!std::isfinite(model.rodRho.at(e)) || model.rodRho.at(e) <= 0) {
+            return "the modal analysis needs a density > 0 for every rod";
+        }
+    }
+
+    Eigen::SparseMatrix<double> M_aa;
+    auto status = assembleMassMatrix(model, settings, factorization, M_aa);
+    if (status != "") {
+        return status;
+    }
+
+    auto applyInverse = [&](const Eigen::VectorXd &b) -> Eigen::VectorXd { // K_aa^-1 * b
+        iterations++;
+        return factorization.solve(b);
+    };
+    Eigen::VectorXd mu;
+    Eigen::MatrixXd phi_a;
+    if (!Lanczos::solve(factorization.K_aa, M_aa, applyInverse, settings.naturalModes, mu, phi_a)) {
+        return "the modal analysis did not converge";
+    }
+    frequencies = mu.cwiseInverse().cwiseSqrt() / (2 * M_PI); // f = omega / (2 * pi) with omega² = 1 / mu
+    Lanczos::scatterModes(factorization, phi_a, modes);
+    return "";
+}
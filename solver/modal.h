@@ -0,0 +1,28 @@
+#ifndef MODAL_H
+#define MODAL_H
+
+#include "calculator.h"
+
+#include <QString>
+
+class FactorizationCache;
+
+// free vibrations: K * phi = omega² * M * phi, M is assembled from the lumped or consistent mass-matrices of the rods (density * A * l per rod, see MassMatrix)
+// this is M * phi = 1 / omega² * K * phi, the lowest natural frequencies are the largest eigenvalues of K^-1 * M, see solver/lanczos.h
+// K is the one of the linear solve() (every rope is taut), its numbering, partition and factorization are reused, only M gets assembled
+namespace Modal
+{
+    // frequencies gets the lowest natural frequencies [Hz] in ascending order (fewer than settings.naturalModes if M has fewer dofs with mass, none without mass)
+    // modes gets one mode-shape per frequency (one entry per dof, 0 at the prescribed dofs, the largest displacement is 1)
+    QString solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, Eigen::VectorXd &frequencies,
+                  Eigen::MatrixXd &modes, int &iterations);
+
+    // M_aa gets the block of the free dofs of the global mass-matrix (numbered and partitioned like the cached K_aa), also used by solver/timehistory.h
+    QString assembleMassMatrix(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization,
+                               Eigen::SparseMatrix<double> &M_aa);
+
+    // mass-matrix of the rod e in global coords (in the order of its coincidence-table)
+    void determineMassESM(const TrussModel &model, RodType type, int e, MassMatrix massMatrix, Calculator::ElementMatrix &m_e);
+}
+
+#endif // MODAL_H
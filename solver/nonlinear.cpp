@@ -0,0 +1,351 @@
+#include "solver/nonlinear.h"
+
+#include "solver/elementtraits.h"
+#include "solver/factorizationcache.h"
+#include "solver/linearsolver.h"
+#include "solver/parallelrange.h"
+#include "solver/partitionedsystem.h"
+
+#include <cmath>
+
+namespace
+{
+    // the full newton-step is accepted if it reduces the out-of-balance work du^T * R to this fraction, otherwise the step-length gets interpolated (secant)
+    const double lineSearchRatio = 0.5;
+    const int maxLineSearches = 4; // per newton-iteration
+    const double minStepLength = 0.1; // relative to the full newton-step
+    // a load-step is halved at most this many times before the analysis gives up (the increment is then 1 / (loadSteps * 2^maxBisections) of the loads)
+    const int maxBisections = 10;
+
+    typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+    // the corotational formulation is written in a right-handed frame (X to the right, Y upwards, rotations counterclockwise) with the dofs X1, Y1, r1, X2, Y2, r2
+    // the model has the y-axis downwards, therefore Y = - y, x and the rotation keep their sign (the ESM of ElementKernel has the same convention)
+    template<typename Traits>
+    struct StandardDofs
+    {
+        int index[Traits::dofCount]; // position of every local dof of the rod-type in the standard frame
+        double sign[Traits::dofCount];
+
+        StandardDofs()
+        {
+            for (int n = 0; n < 2; n++) {
+                index[Traits::x(n)] = 3 * n;
+                sign[Traits::x(n)] = 1;
+                index[Traits::y(n)] = 3 * n + 1;
+                sign[Traits::y(n)] = -1;
+                if (Traits::hasBending) {
+                    index[Traits::m(n)] = 3 * n + 2;
+                    sign[Traits::m(n)] = 1;
+                }
+            }
+        }
+    };
+
+    template<typename Traits>
+    double determineCorotationalForces(const TrussModel &model, int e, const QVector<int> &dof, const Eigen::VectorXd &U, Nonlinear::ElementVector &f_e,
+                                       Calculator::ElementMatrix *k_t, bool &slack)
+    {
+        static const StandardDofs<Traits> dofMap;
+        Vector6d d = Vector6d::Zero(); // displacements in the standard frame, the rotations of bars and ropes stay 0 (they do not contribute)
+        for (int i = 0; i < Traits::dofCount; i++) {
+            d(dofMap.index[i]) = dofMap.sign[i] * U(dof.at(i));
+        }
+        double l0 = model.getRodLength(e);
+        double angle0 = model.getRodAngle(e);
+        double c0 = cos(angle0);
+        double s0 = sin(angle0);
+        double dX = l0 * c0 + d(3) - d(0); // chord of the deformed rod
+        double dY = l0 * s0 + d(4) - d(1);
+        double l = sqrt(dX * dX + dY * dY);
+        double c = dX / l;
+        double s = dY / l;
+        double rigidRotation = atan2(c0 * s - s0 * c, c0 * c + s0 * s); // rotation of the chord, within [-pi; +pi]
+        if (Traits::hasBending) { // a rod that rolls up turns by more than pi, take the turn of the chord next to the mean rotation of the ends
+            rigidRotation += 2 * M_PI * std::round(((d(2) + d(5)) / 2 - rigidRotation) / (2 * M_PI));
+        }
+        double ddX = d(3) - d(0);
+        double ddY = d(4) - d(1);
+        double elongation = (ddX * (2 * l0 * c0 + ddX) + ddY * (2 * l0 * s0 + ddY)) / (l + l0); // l - l0 = (l^2 - l0^2) / (l + l0) without cancellation
+        f_e = Nonlinear::ElementVector::Zero(Traits::dofCount);
+        if (k_t != nullptr) {
+            *k_t = Calculator::ElementMatrix::Zero(Traits::dofCount, Traits::dofCount);
+        }
+        slack = Traits::tensionOnly && elongation < 0;
+        if (slack) { // a slack rope has neither force nor stiffness
+            return 0;
+        }
+
+        // local deformations: elongation and the rotations of the ends relative to the chord, the linear element relates them to N, M1 and M2
+        double EA_l = model.rodE.at(e) * model.rodA.at(e) / l0;
+        double EI_l = model.rodE.at(e) * Traits::bendingStiffness(model.rodI.at(e)) / l0;
+        double phi1 = d(2) - rigidRotation;
+        double phi2 = d(5) - rigidRotation;
+        double N = EA_l * elongation;
+        double M1 = EI_l * (4 * phi1 + 2 * phi2);
+        double M2 = EI_l * (2 * phi1 + 4 * phi2);
+
+        // variations of the local deformations: d(elongation) = r^T * d(d), d(rigidRotation) = z^T * d(d) / l, d(phi) = d(rotation) - z^T * d(d) / l
+        Vector6d r;
+        r << - c, - s, 0, c, s, 0;
+        Vector6d z;
+        z << s, - c, 0, - s, c, 0;
+        Vector6d b1 = - z / l;
+        b1(2) += 1;
+        Vector6d b2 = - z / l;
+        b2(5) += 1;
+        Vector6d f = N * r + M1 * b1 + M2 * b2;
+        for (int i = 0; i < Traits::dofCount; i++) {
+            f_e(i) = dofMap.sign[i] * f(dofMap.index[i]);
+        }
+        if (k_t != nullptr) {
+            // material part B^T * D * B and geometric part from the change of r and z with the rotation of the chord
+            Eigen::Matrix<double, 6, 6> K = EA_l * r * r.transpose() + N / l * z * z.transpose();
+            if (Traits::hasBending) {
+                K += EI_l * (4 * b1 * b1.transpose() + 2 * b1 * b2.transpose() + 2 * b2 * b1.transpose() + 4 * b2 * b2.transpose())
+                        + (M1 + M2) / (l * l) * (r * z.transpose() + z * r.transpose());
+            }
+            for (int i = 0; i < Traits::dofCount; i++) {
+                for (int j = 0; j < Traits::dofCount; j++) {
+                    (*k_t)(i, j) = dofMap.sign[i] * dofMap.sign[j] * K(dofMap.index[i], dofMap.index[j]);
+                }
+            }
+        }
+        return N;
+    }
+
+    struct State // internal forces of the whole system at the displacements of one column
+    {
+        Eigen::VectorXd f; // one entry per dof
+        Eigen::VectorXd N; // one entry per rod
+        QVector<Calculator::ElementMatrix> k_t; // tangent-ESMs, only filled if requested
+    };
+
+    void evaluate(const TrussModel &model, const FactorizationCache &factorization, const Eigen::VectorXd &U, int threadCount, bool withTangent, State &state)
+    {
+        int rodCount = model.getRodCount();
+        QVector<Nonlinear::ElementVector> f_es(rodCount);
+        state.N.resize(rodCount);
+        if (withTangent) {
+            state.k_t.resize(rodCount);
+        }
+        Nonlinear::ElementVector *f_e = f_es.data(); // detach here and not on the threads
+        Calculator::ElementMatrix *k_t = withTangent ? state.k_t.data() : nullptr;
+        double *N = state.N.data();
+        int rangeCount = Parallel::determineRangeCount(rodCount, Parallel::determineThreadCount(threadCount), Parallel::minRodsPerThread);
+        Parallel::forEachRange(rodCount, rangeCount, [&](int, int begin, int end) {
+            for (int e = begin; e < end; e++) {
+                bool slack = false;
+                N[e] = Nonlinear::determineRodForces(model, factorization.rodTypes.at(e), e, factorization.coincidenceTable.at(e), U, f_e[e],
+                                                     k_t != nullptr ? k_t + e : nullptr, slack);
+            }
+        });
+        state.f = Eigen::VectorXd::Zero(U.size()); // summed up in the order of the rods, therefore independent of the threads
+        for (int e = 0; e < rodCount; e++) {
+            const QVector<int> &dof = factorization.coincidenceTable.at(e);
+            for (int i = 0; i < dof.size(); i++) {
+                state.f(dof.at(i)) += f_es.at(e)(i);
+            }
+        }
+    }
+
+    QString factorizeTangent(const FactorizationCache &factorization, const Calculator::SolverSettings &settings, const State &state, LinearSolver &solver)
+    {
+        // same assembly and backend as the linear K (see Calculator::factorizeSystem()), only the ESMs differ
+        int dofCount = factorization.dofCount;
+        int rodCount = state.k_t.size();
+        const PartitionedSystem &system = factorization.system;
+        QString status;
+        if (dofCount > settings.sparseAssemblyThreshold) {
+            Eigen::SparseMatrix<double> K, K_aa, K_ab, K_ba, K_bb;
+            status = Calculator::assembleSparseGSM(dofCount, rodCount, factorization.coincidenceTable, state.k_t, settings.threadCount, K);
+            if (status == "") {
+                system.extractBlocks(K, K_aa, K_ab, K_ba, K_bb);
+                solver.factorize(K_aa);
+            }
+        } else {
+            Eigen::MatrixXd K = Eigen::MatrixXd::Zero(dofCount, dofCount);
+            Eigen::MatrixXd K_aa, K_ab, K_ba, K_bb;
+            status = Calculator::assembleGSM(dofCount, rodCount, factorization.coincidenceTable, state.k_t, K);
+            if (status == "") {
+                system.extractBlocks(K, K_aa, K_ab, K_ba, K_bb);
+                solver.factorize(K_aa);
+            }
+        }
+        return status;
+    }
+
+    Eigen::VectorXd determineResidual(const PartitionedSystem &system, const Eigen::VectorXd &F_a, double loadFactor, const State &state)
+    {
+        Eigen::VectorXd R = loadFactor * F_a;
+        const QVector<int> &freeDofs = system.getFreeDofs();
+        for (int i = 0; i < freeDofs.size(); i++) {
+            R(i) -= state.f(freeDofs.at(i));
+        }
+        return R;
+    }
+
+    double determineReference(const Eigen::VectorXd &F_a, double loadFactor, const State &state) // the norm the out-of-balance forces are compared to
+    {
+        return fmax(loadFactor * F_a.norm(), state.f.norm()); // state.f includes the reactions, so that a system only loaded by prescribed displacements converges too
+    }
+
+    // newton-raphson for the equilibrium at loadFactor, U is the predictor on input (its prescribed dofs have to be set) and the converged displacements on output
+    // returns false if the iteration did not converge or the tangent got singular (limit point or kinematic system), report holds the iterations in both cases
+    bool iterate(const FactorizationCache &factorization, const Calculator::SolverSettings &settings, const TrussModel &model, const Eigen::VectorXd &F_a,
+                 double loadFactor, Eigen::VectorXd &U, State &state, LinearSolver &solver, Calculator::LoadStepReport &report)
+    {
+        const PartitionedSystem &system = factorization.system;
+        const QVector<int> &freeDofs = system.getFreeDofs();
+        report.loadFactor = loadFactor;
+        report.iterations = 0;
+        report.lineSearches = 0;
+        evaluate(model, factorization, U, settings.threadCount, true, state);
+        Eigen::VectorXd R = determineResidual(system, F_a, loadFactor, state);
+        for (;;) {
+            double reference = determineReference(F_a, loadFactor, state);
+            report.residual = reference > 0 ? R.norm() / reference : 0;
+            if (!std::isfinite(report.residual)) {
+                return false;
+            }
+            if (report.residual <= settings.newtonTolerance) {
+                report.converged = true;
+                return true;
+            }
+            if (report.iterations == settings.maxNewtonIterations) {
+                return false;
+            }
+            report.iterations++;
+            if (factorizeTangent(factorization, settings, state, solver) != "" || solver.isSingular()) {
+                return false;
+            }
+            Eigen::VectorXd dU_a = solver.solve(R).col(0);
+
+            // line-search along dU_a: the out-of-balance work s(eta) = dU_a^T * R(U + eta * dU_a) should vanish, s(0) > 0 for a positive definite tangent
+            Eigen::VectorXd start = U;
+            double s0 = dU_a.dot(R);
+            double stepLength = 1;
+            for (int search = 0; ; search++) {
+                U = start;
+                for (int i = 0; i < freeDofs.size(); i++) {
+                    U(freeDofs.at(i)) += stepLength * dU_a(i);
+                }
+                evaluate(model, factorization, U, settings.threadCount, true, state); // with the tangent, the accepted step needs it for the next iteration
+                R = determineResidual(system, F_a, loadFactor, state);
+                double s = dU_a.dot(R);
+                if (search == maxLineSearches || fabs(s) <= lineSearchRatio * fabs(s0) || s0 == s) {
+                    break;
+                }
+                double newStepLength = stepLength * s0 / (s0 - s); // secant through s(0) and s(stepLength)
+                if (!std::isfinite(newStepLength) || newStepLength < minStepLength) {
+                    newStepLength = minStepLength;
+                } else if (newStepLength > 1) {
+                    newStepLength = 1;
+                }
+                if (newStepLength == stepLength) {
+                    break;
+                }
+                stepLength = newStepLength;
+                report.lineSearches++;
+            }
+        }
+    }
+
+    void setPrescribedDofs(const PartitionedSystem &system, const Eigen::VectorXd &U_b, double loadFactor, Eigen::VectorXd &U)
+    {
+        const QVector<int> &prescribedDofs = system.getPrescribedDofs();
+        for (int i = 0; i < prescribedDofs.size(); i++) {
+            U(prescribedDofs.at(i)) = loadFactor * U_b(i);
+        }
+    }
+} // end anonymous namespace
+
+double Nonlinear::determineRodForces(const TrussModel &model, RodType type, int e, const QVector<int> &dof, const Eigen::VectorXd &U, ElementVector &f_e,
+                                     Calculator::ElementMatrix *k_t, bool &slack)
+{
+    double N = 0;
+    visitRodType(type, [&](auto traits) {
+        N = determineCorotationalForces<decltype(traits)>(model, e, dof, U, f_e, k_t, slack);
+    });
+    return N;
+}
+
+QString Nonlinear::solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, const Eigen::MatrixXd &F_a,
+                         const Eigen::MatrixXd &U_b, const Eigen::MatrixXd &U_start, Eigen::MatrixXd &U, Eigen::MatrixXd &F, Eigen::MatrixXd &innerForces,
+                         QVector<QVector<int>> &slackRopes, QVector<Calculator::LoadStepReport> &report)
+{
+    const PartitionedSystem &system = factorization.system;
+    int loadSteps = qMax(settings.loadSteps, 1);
+    bool hasWarmStart = U_start.rows() == U.rows() && U_start.cols() == U.cols();
+    LinearSolver solver(settings.solverBackend, settings.dofOrdering != DofOrdering::Natural);
+    State state;
+    report.clear();
+    slackRopes.resize(U.cols());
+    innerForces.resize(model.getRodCount(), U.cols());
+    for (int column = 0; column < U.cols(); column++) {
+        const Eigen::VectorXd f_a = F_a.col(column);
+        const Eigen::VectorXd u_b = U_b.col(column);
+        Eigen::VectorXd u;
+        bool converged = false;
+        if (hasWarmStart) { // the converged state of the last solve() is usually close, then the full load converges in a few iterations
+            u = U_start.col(column);
+            setPrescribedDofs(system, u_b, 1, u);
+            Calculator::LoadStepReport step;
+            step.column = column;
+            step.warmStart = true;
+            converged = iterate(factorization, settings, model, f_a, 1, u, state, solver, step);
+            report.append(step);
+        }
+        if (!converged) {
+            // load-steps from the unloaded system, the predictor extrapolates the rate of the displacements dU / d(loadFactor) of the last step
+            // the tangent of the unloaded system is the linear K, therefore the linear solution is the rate of the first step
+            Eigen::VectorXd rate = U.col(column);
+            Eigen::VectorXd convergedU = Eigen::VectorXd::Zero(U.rows());
+            double loadFactor = 0;
+            double increment = 1.0 / loadSteps;
+            int bisections = 0;
+            while (loadFactor < 1) {
+                double nextLoadFactor = loadFactor + increment > 1 - 1e-12 ? 1 : loadFactor + increment;
+                u = convergedU + (nextLoadFactor - loadFactor) * rate;
+                setPrescribedDofs(system, u_b, nextLoadFactor, u);
+                Calculator::LoadStepReport step;
+                step.column = column;
+                bool stepConverged = iterate(factorization, settings, model, f_a, nextLoadFactor, u, state, solver, step);
+                report.append(step);
+                if (stepConverged) {
+                    rate = (u - convergedU) / (nextLoadFactor - loadFactor);
+                    convergedU = u;
+                    loadFactor = nextLoadFactor;
+                    increment = fmin(2 * increment, 1.0 / loadSteps); // back to the requested increment after a bisection
+                } else {
+                    if (++bisections > maxBisections) {
+                        return "the second-order analysis did not converge at " + QString::number(100 * nextLoadFactor, 'g', 4)
+                                + " % of the loads (limit point, e.g. buckling, or kinematic system)";
+                    }
+                    increment /= 2;
+                }
+            }
+            u = convergedU;
+        }
+
+        // the final state: displacements, reactions (internal forces at the prescribed dofs) and normal-forces
+        evaluate(model, factorization, u, settings.threadCount, false, state);
+        U.col(column) = u;
+        for (int dof = 0; dof < U.rows(); dof++) {
+            F(dof, column) = system.isFree(dof) ? f_a(system.getLocalIndex(dof)) : state.f(dof);
+        }
+        innerForces.col(column) = state.N;
+        slackRopes[column].clear();
+        for (int e = 0; e < model.getRodCount(); e++) {
+            if (factorization.rodTypes.at(e) == RodType::Rope) {
+                bool slack = false;
+                Nonlinear::ElementVector f_e;
+                determineRodForces(model, RodType::Rope, e, factorization.coincidenceTable.at(e), u, f_e, nullptr, slack);
+                if (slack) {
+                    slackRopes[column].append(e);
+                }
+            }
+        }
+    }
+    return "";
+}
@@ -0,0 +1,33 @@
+#ifndef NONLINEAR_H
+#define NONLINEAR_H
+
+#include "calculator.h"
+
+#include <QString>
+#include <QVector>
+
+class FactorizationCache;
+
+// geometrically nonlinear (second-order) analysis: the equilibrium is formulated on the deformed system, every rod is a corotational element
+// the rigid-body-motion of a rod (translation and rotation of its chord) is split off, the remaining deformations are small and use the linear ESM in the rotated frame
+// the loads are applied in equal increments (load-steps), every step is solved with newton-raphson on the tangent-stiffness-matrix (material + geometric part) and a line-search
+// a step that does not converge (e.g. near a limit point) is repeated with half the load-increment
+// the numbering, the partition and the linear solution (the first newton-iterate of the first step, the tangent of the unloaded system is the linear K) come from the linear solve()
+namespace Nonlinear
+{
+    typedef Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor, 6, 1> ElementVector; // 6 entries for beams, 4 for bars and ropes, like Calculator::ElementMatrix
+
+    // U holds the linear solution of every column on input and the converged displacements on output, F the reactions, innerForces the normal-forces in the deformed system
+    // U_start: converged displacements of the last solve() (e.g. while a load gets dragged), every column is tried with the full load first, ignored if its size does not match
+    // a rope is slack if it gets shorter, then it has neither stiffness nor force, slackRopes gets the slack ropes of every column
+    QString solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, const Eigen::MatrixXd &F_a,
+                  const Eigen::MatrixXd &U_b, const Eigen::MatrixXd &U_start, Eigen::MatrixXd &U, Eigen::MatrixXd &F, Eigen::MatrixXd &innerForces,
+                  QVector<QVector<int>> &slackRopes, QVector<Calculator::LoadStepReport> &report);
+
+    // internal forces of the rod e in global coords (in the order of its coincidence-table) at the displacements U of all dofs, returns the normal-force
+    // k_t gets the tangent-ESM if it is not nullptr, slack is set to true for a rope that got shorter
+    double determineRodForces(const TrussModel &model, RodType type, int e, const QVector<int> &dof, const Eigen::VectorXd &U, ElementVector &f_e,
+                              Calculator::ElementMatrix *k_t, bool &slack);
+}
+
+#endif // NONLINEAR_H
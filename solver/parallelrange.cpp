@@ -0,0 +1,69 @@
+#include "solver/parallelrange.h"
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+namespace
+{
+    class RangeTask final : public QRunnable // deleted by the pool after run()
+    {
+    public:
+        RangeTask(const std::function<void(int, int, int)> &fct, int range, int begin, int end, QSemaphore &done) :
+            fct(fct), range(range), begin(begin), end(end), done(done) {}
+
+        void run() override
+        {
+            fct(range, begin, end);
+            done.release();
+        }
+
+    private:
+        const std::function<void(int, int, int)> &fct; // outlives the task because forEachRange() waits for all tasks
+        int range;
+        int begin;
+        int end;
+        QSemaphore &done;
+    };
+
+    QThreadPool &getPool()
+    {
+        // not the global pool, the cli solves whole files on that one, the tasks of this pool never wait for other tasks, so nothing can deadlock
+        static QThreadPool pool;
+        return pool;
+    }
+
+    int getRangeBegin(int count, int rangeCount, int range)
+    {
+        return static_cast<int>(static_cast<qint64>(count) * range / rangeCount);
+    }
+} // end anonymous namespace
+
+int Parallel::determineThreadCount(int requested)
+{
+    return requested > 0 ? requested : qMax(1, QThread::idealThreadCount());
+}
+
+int Parallel::determineRangeCount(int count, int threadCount, int minRangeSize)
+{
+    return qMax(1, qMin(threadCount, count / qMax(1, minRangeSize)));
+}
+
+void Parallel::forEachRange(int count, int rangeCount, const std::function<void(int, int, int)> &fct)
+{
+    if (rangeCount <= 1) {
+        fct(0, 0, count);
+        return;
+    }
+    QThreadPool &pool = getPool();
+    if (pool.maxThreadCount() < rangeCount - 1) { // more threads than cores were requested
+        pool.setMaxThreadCount(rangeCount - 1);
+    }
+    QSemaphore done;
+    for (int range = 1; range < rangeCount; range++) {
+        pool.start(new RangeTask(fct, range, getRangeBegin(count, rangeCount, range), getRangeBegin(count, rangeCount, range + 1), done));
+    }
+    fct(0, 0, getRangeBegin(count, rangeCount, 1));
+    done.acquire(rangeCount - 1);
+}
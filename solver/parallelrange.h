@@ -0,0 +1,18 @@
+#ifndef PARALLELRANGE_H
+#define PARALLELRANGE_H
+
+#include <functional>
+
+namespace Parallel
+{
+    // below this many rods per thread the per-rod work (element-matrices, element-forces, triplets) is cheaper to do on the calling thread than to hand over to the pool
+    const int minRodsPerThread = 2048;
+
+    // splits [0, count) into contiguous ranges that are processed on the threads of the solver-pool, the calling thread processes the first range itself
+    // the ranges only depend on count and rangeCount, never on the scheduling, therefore results that get merged in the order of the ranges are deterministic
+    int determineThreadCount(int requested); // requested <= 0: number of cores
+    int determineRangeCount(int count, int threadCount, int minRangeSize); // at least 1, so that small systems stay on the calling thread
+    void forEachRange(int count, int rangeCount, const std::function<void(int range, int begin, int end)> &fct); // returns after all ranges are done
+}
+
+#endif // PARALLELRANGE_H
@@ -0,0 +1,111 @@
+#include "partitionedsystem.h"
+
+QString PartitionedSystem::partition(const Eigen::VectorXb &F_k, const Eigen::VectorXb &U_k)
+{
+    int dofCount = static_cast<int>(F_k.size());
+    freeDofs.clear();
+    prescribedDofs.clear();
+    free = QVector<bool>(dofCount, false);
+    localIndex = QVector<int>(dofCount, -1);
+    for (int i = 0; i < dofCount; i++) {
+        if (F_k(i) == U_k(i)) { // either the force or the displacement has to be known, otherwise the system is over- or underdetermined
+            return "knownFs + knownUs has to equal the dofCount!";
+        }
+        if (F_k(i)) {
+            free[i] = true;
+            localIndex[i] = freeDofs.size();
+            freeDofs.append(i);
+        } else {
+            localIndex[i] = prescribedDofs.size();
+            prescribedDofs.append(i);
+        }
+    }
+    return "";
+}
+
+void PartitionedSystem::extractBlocks(const Eigen::MatrixXd &K, Eigen::MatrixXd &K_aa, Eigen::MatrixXd &K_ab, Eigen::MatrixXd &K_ba, Eigen::MatrixXd &K_bb) const
+{
+    int a = freeDofs.size();
+    int b = prescribedDofs.size();
+    K_aa.resize(a, a);
+    K_ab.resize(a, b);
+    K_ba.resize(b, a);
+    K_bb.resize(b, b);
+    for (int j = 0; j < a; j++) { // column-wise because eigen stores matrices column-major
+        for (int i = 0; i < a; i++) {
+            K_aa(i, j) = K(freeDofs.at(i), freeDofs.at(j));
+        }
+        for (int i = 0; i < b; i++) {
+            K_ba(i, j) = K(prescribedDofs.at(i), freeDofs.at(j));
+        }
+    }
+    for (int j = 0; j < b; j++) {
+        for (int i = 0; i < a; i++) {
+            K_ab(i, j) = K(freeDofs.at(i), prescribedDofs.at(j));
+        }
+        for (int i = 0; i < b; i++) {
+            K_bb(i, j) = K(prescribedDofs.at(i), prescribedDofs.at(j));
+        }
+    }
+}
+
+void PartitionedSystem::extractBlocks(const Eigen::SparseMatrix<double> &K, Eigen::SparseMatrix<double> &K_aa, Eigen::SparseMatrix<double> &K_ab,
+                                      Eigen::SparseMatrix<double> &K_ba, Eigen::SparseMatrix<double> &K_bb) const
+{
+    // every non-zero entry of K is moved into the block it belongs to in a single pass
+    QVector<Eigen::Triplet<double>> t_aa, t_ab, t_ba, t_bb;
+    t_aa.reserve(static_cast<int>(K.nonZeros()));
+    for (int col = 0; col < K.outerSize(); col++) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(K, col); it; ++it) {
+            int row = static_cast<int>(it.row());
+            Eigen::Triplet<double> t(localIndex.at(row), localIndex.at(col), it.value());
+            if (free.at(row) && free.at(col)) {
+                t_aa.append(t);
+            } else if (free.at(row)) {
+                t_ab.append(t);
+            } else if (free.at(col)) {
+                t_ba.append(t);
+            } else {
+                t_bb.append(t);
+            }
+        }
+    }
+    int a = freeDofs.size();
+    int b = prescribedDofs.size();
+    K_aa.resize(a, a);
+    K_aa.setFromTriplets(t_aa.begin(), t_aa.end());
+    K_ab.resize(a, b);
+    K_ab.setFromTriplets(t_ab.begin(), t_ab.end());
+    K_ba.resize(b, a);
+    K_ba.setFromTriplets(t_ba.begin(), t_ba.end());
+    K_bb.resize(b, b);
+    K_bb.setFromTriplets(t_bb.begin(), t_bb.end());
+}
+
+Eigen::MatrixXd PartitionedSystem::getF_a(const Eigen::MatrixXd &F) const
+{
+    Eigen::MatrixXd F_a(freeDofs.size(), F.cols());
+    for (int i = 0; i < freeDofs.size(); i++) {
+        F_a.row(i) = F.row(freeDofs.at(i));
+    }
+    return F_a;
+}
+
+Eigen::MatrixXd PartitionedSystem::getU_b(const Eigen::MatrixXd &U) const
+{
+    Eigen::MatrixXd U_b(prescribedDofs.size(), U.cols());
+    for (int i = 0; i < prescribedDofs.size(); i++) {
+        U_b.row(i) = U.row(prescribedDofs.at(i));
+    }
+    return U_b;
+}
+
+void PartitionedSystem::scatterResults(const Eigen::MatrixXd &U_a, const Eigen::MatrixXd &F_b, Eigen::MatrixXd &U, Eigen::MatrixXd &F) const
+{
+    for (int i = 0; i < freeDofs.size(); i++) {
+        U.row(freeDofs.at(i)) = U_a.row(i);
+    }
+    for (int i = 0; i < prescribedDofs.size(); i++) {
+        F.row(prescribedDofs.at(i)) = F_b.row(i);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef PARTITIONEDSYSTEM_H
+#define PARTITIONEDSYSTEM_H
+
+#include "libs/Eigen/Eigen/Eigen"
+
+#include <QString>
+#include <QVector>
+
+// splits K * U = F into the free dofs (index a: F known, U unknown) and the prescribed dofs (index b: U known, F unknown):
+//      (K_aa, K_ab,  *  (U_a,  =  (F_a,
+//       K_ba, K_bb)      U_b)      F_b)
+// the blocks are extracted directly from K via the index lists, therefore no permuted copies of K are needed
+class PartitionedSystem
+{
+public:
+    explicit PartitionedSystem() = default;
+
+    QString partition(const Eigen::VectorXb &F_k, const Eigen::VectorXb &U_k); // returns an error-message if a dof has not exactly one known value, "" otherwise
+
+    int getDofCount() const { return localIndex.size(); }
+    const QVector<int> &getFreeDofs() const { return freeDofs; } // global dof-ids of U_a (and F_a), in ascending order
+    const QVector<int> &getPrescribedDofs() const { return prescribedDofs; } // global dof-ids of U_b (and F_b), in ascending order
+    bool isFree(int dof) const { return free.at(dof); }
+    int getLocalIndex(int dof) const { return localIndex.at(dof); } // index of the dof within the a- or b-part
+
+    void extractBlocks(const Eigen::MatrixXd &K, Eigen::MatrixXd &K_aa, Eigen::MatrixXd &K_ab, Eigen::MatrixXd &K_ba, Eigen::MatrixXd &K_bb) const;
+    void extractBlocks(const Eigen::SparseMatrix<double> &K, Eigen::SparseMatrix<double> &K_aa, Eigen::SparseMatrix<double> &K_ab, Eigen::SparseMatrix<double> &K_ba,
+                       Eigen::SparseMatrix<double> &K_bb) const;
+
+    // F and U hold one column per load-case
+    Eigen::MatrixXd getF_a(const Eigen::MatrixXd &F) const; // gathers the known forces
+    Eigen::MatrixXd getU_b(const Eigen::MatrixXd &U) const; // gathers the known displacements
+    void scatterResults(const Eigen::MatrixXd &U_a, const Eigen::MatrixXd &F_b, Eigen::MatrixXd &U, Eigen::MatrixXd &F) const; // puts the solved unknowns back into U and F
+
+private:
+    QVector<int> freeDofs;
+    QVector<int> prescribedDofs;
+    QVector<bool> free; // free.at(dof) is true if the dof belongs to the a-part
+    QVector<int> localIndex;
+};
+
+#endif // PARTITIONEDSYSTEM_H
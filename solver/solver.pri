@@ -0,0 +1,42 @@
+# calculator-core shared by TrussCalculator.pro and trusscalc-cli.pro, it only depends on QtCore and Eigen
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    $$PWD/buckling.cpp \
+    $$PWD/calculatorcore.cpp \
+    $$PWD/dofordering.cpp \
+    $$PWD/elementkernel.cpp \
+    $$PWD/elementkernelavx.cpp \
+    $$PWD/factorizationcache.cpp \
+    $$PWD/lanczos.cpp \
+    $$PWD/linearsolver.cpp \
+    $$PWD/loadcombination.cpp \
+    $$PWD/modal.cpp \
+    $$PWD/nonlinear.cpp \
+    $$PWD/parallelrange.cpp \
+    $$PWD/partitionedsystem.cpp \
+    $$PWD/tensiononly.cpp \
+    $$PWD/timehistory.cpp \
+    $$PWD/trussmodel.cpp
+
+HEADERS += \
+    $$PWD/../calculator.h \
+    $$PWD/../elements/elementtypes.h \
+    $$PWD/../libs/Eigen/Eigen/Eigen \
+    $$PWD/buckling.h \
+    $$PWD/dofordering.h \
+    $$PWD/elementkernel.h \
+    $$PWD/elementkernelsimd.h \
+    $$PWD/elementtraits.h \
+    $$PWD/factorizationcache.h \
+    $$PWD/lanczos.h \
+    $$PWD/linearsolver.h \
+    $$PWD/loadcombination.h \
+    $$PWD/modal.h \
+    $$PWD/nonlinear.h \
+    $$PWD/parallelrange.h \
+    $$PWD/partitionedsystem.h \
+    $$PWD/tensiononly.h \
+    $$PWD/timehistory.h \
+    $$PWD/trussmodel.h
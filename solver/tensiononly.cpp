@@ -0,0 +1,244 @@
+#include "solver/tensiononly.h"
+
+#include "solver/elementtraits.h"
+#include "solver/factorizationcache.h"
+
+#include <QHash>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // a set of slack ropes that still changes after this many iterations is reported as not converged (e.g. if the iteration alternates between two sets)
+    const int maxIterations = 100;
+    // a rope counts as compressed (a slack rope as elongated) if its normal-force exceeds this fraction of the largest rope-force or load of the column
+    const double relativeForceTolerance = 1e-9;
+    // relative residual of the corrected system above which the system without the slack ropes is assumed to be kinematic
+    const double maxRelativeResidual = 1e-8;
+
+    typedef ElementTraits<RodType::Rope> Rope;
+
+    struct RopeData
+    {
+        int rod;
+        double c; // cos and sin of the rod-angle, like in Calculator::determineInnerForces()
+        double s;
+        double EA_l; // [N/m]
+    };
+
+    // entries of K_aa^-1 between the free dofs of the slack ropes, every column of K_aa^-1 is solved only once for all iterations and columns of the right-hand-side
+    // K_aa is symmetric, therefore a new column also yields the row of the new dof in the columns solved before
+    struct InverseEntries
+    {
+        QHash<int, int> index; // local free dof -> index in G
+        Eigen::MatrixXd G;
+        QVector<int> dofs; // local free dof of every index
+    };
+
+    void addInverseEntries(const FactorizationCache &factorization, const QVector<int> &dofs, InverseEntries &inverse)
+    {
+        QVector<int> missing;
+        for (int dof : dofs) {
+            if (!inverse.index.contains(dof)) {
+                missing.append(dof);
+            }
+        }
+        if (missing.isEmpty()) {
+            return;
+        }
+        int freeDofCount = factorization.system.getFreeDofs().size();
+        Eigen::MatrixXd P = Eigen::MatrixXd::Zero(freeDofCount, missing.size());
+        for (int i = 0; i < missing.size(); i++) {
+            P(missing.at(i), i) = 1;
+        }
+        Eigen::MatrixXd Z = factorization.solve(P); // one forward/back-substitution per new dof
+        int oldCount = inverse.dofs.size();
+        for (int dof : missing) {
+            inverse.index.insert(dof, inverse.dofs.size());
+            inverse.dofs.append(dof);
+        }
+        int newCount = inverse.dofs.size();
+        inverse.G.conservativeResize(newCount, newCount);
+        for (int i = 0; i < missing.size(); i++) {
+            for (int row = 0; row < newCount; row++) {
+                double value = Z(inverse.dofs.at(row), i);
+                inverse.G(row, oldCount + i) = value;
+                inverse.G(oldCount + i, row) = value;
+            }
+        }
+    }
+
+    double value(const PartitionedSystem &system, const Eigen::VectorXd &u_a, const Eigen::MatrixXd &U_b, int column, int dof)
+    {
+        return system.isFree(dof) ? u_a(system.getLocalIndex(dof)) : U_b(system.getLocalIndex(dof), column);
+    }
+
+    double determineRopeForce(const FactorizationCache &factorization, const RopeData &rope, const Eigen::VectorXd &u_a, const Eigen::MatrixXd &U_b, int column)
+    {
+        // normal-force as if the rope were active, see Calculator::determineInnerForces()
+        const PartitionedSystem &system = factorization.system;
+        const QVector<int> &dof = factorization.coincidenceTable.at(rope.rod);
+        double u1 = value(system, u_a, U_b, column, dof.at(Rope::x(0))) * rope.c - value(system, u_a, U_b, column, dof.at(Rope::y(0))) * rope.s;
+        double u2 = value(system, u_a, U_b, column, dof.at(Rope::x(1))) * rope.c - value(system, u_a, U_b, column, dof.at(Rope::y(1))) * rope.s;
+        return rope.EA_l * (u2 - u1);
+    }
+
+    QString solveWithoutSlackRopes(const FactorizationCache &factorization, const QVector<int> &slack, const Eigen::VectorXd &y, const Eigen::VectorXd &f,
+                                   InverseEntries &inverse, Eigen::VectorXd &u)
+    {
+        // K_aa,slack = K_aa + P * C * P^T with C = - sum of the ESMs of the slack ropes (free dofs only), y = K_aa^-1 * f
+        // then u = K_aa,slack^-1 * f = y - K_aa^-1 * P * (I + C * P^T * K_aa^-1 * P)^-1 * C * P^T * y
+        if (slack.isEmpty()) {
+            u = y;
+            return "";
+        }
+        const PartitionedSystem &system = factorization.system;
+        QVector<int> dofs;
+        QHash<int, int> position; // local free dof -> index in C
+        for (int e : slack) {
+            for (int dof : factorization.coincidenceTable.at(e)) {
+                if (system.isFree(dof) && !position.contains(system.getLocalIndex(dof))) {
+                    position.insert(system.getLocalIndex(dof), dofs.size());
+                    dofs.append(system.getLocalIndex(dof));
+                }
+            }
+        }
+        int rank = dofs.size();
+        Eigen::MatrixXd C = Eigen::MatrixXd::Zero(rank, rank);
+        for (int e : slack) {
+            const QVector<int> &dof = factorization.coincidenceTable.at(e);
+            const Calculator::ElementMatrix &k_e = factorization.elementMatrices.at(e);
+            for (int i = 0; i < dof.size(); i++) {
+                for (int j = 0; j < dof.size(); j++) {
+                    if (system.isFree(dof.at(i)) && system.isFree(dof.at(j))) {
+                        C(position.value(system.getLocalIndex(dof.at(i))), position.value(system.getLocalIndex(dof.at(j)))) -= k_e(i, j);
+                    }
+                }
+            }
+        }
+        addInverseEntries(factorization, dofs, inverse);
+        Eigen::MatrixXd Z_c(rank, rank); // P^T * K_aa^-1 * P
+        Eigen::VectorXd y_c(rank); // P^T * y
+        for (int i = 0; i < rank; i++) {
+            for (int j = 0; j < rank; j++) {
+                Z_c(i, j) = inverse.G(inverse.index.value(dofs.at(i)), inverse.index.value(dofs.at(j)));
+            }
+            y_c(i) = y(dofs.at(i));
+        }
+        Eigen::VectorXd w = Eigen::PartialPivLU<Eigen::MatrixXd>(Eigen::MatrixXd::Identity(rank, rank) + C * Z_c).solve(C * y_c);
+        Eigen::MatrixXd Pw = Eigen::MatrixXd::Zero(y.size(), 1);
+        for (int i = 0; i < rank; i++) {
+            Pw(dofs.at(i), 0) = w(i);
+        }
+        u = y - factorization.solve(Pw).col(0); // one more substitution instead of storing K_aa^-1 * P
+
+        // if the slack ropes leave a part of the system without support, the corrected matrix is singular and u is meaningless
+        Eigen::VectorXd residual = factorization.K_aa * u - f;
+        for (int e : slack) {
+            const QVector<int> &dof = factorization.coincidenceTable.at(e);
+            const Calculator::ElementMatrix &k_e = factorization.elementMatrices.at(e);
+            for (int i = 0; i < dof.size(); i++) {
+                for (int j = 0; j < dof.size(); j++) {
+                    if (system.isFree(dof.at(i)) && system.isFree(dof.at(j))) {
+                        residual(system.getLocalIndex(dof.at(i))) -= k_e(i, j) * u(system.getLocalIndex(dof.at(j)));
+                    }
+                }
+            }
+        }
+        if (!residual.allFinite() || residual.norm() > maxRelativeResidual * fmax(f.norm(), std::numeric_limits<double>::min())) {
+            return "the system is kinematic without the slack ropes";
+        }
+        return "";
+    }
+} // end anonymous namespace
+
+QString TensionOnly::solve(const TrussModel &model, const FactorizationCache &factorization, const Eigen::MatrixXd &F_a_reduced, const Eigen::MatrixXd &U_b,
+                           Eigen::MatrixXd &U_a, QVector<QVector<int>> &slackRopes, int &iterations)
+{
+    QVector<RopeData> ropes;
+    for (int e = 0; e < model.getRodCount(); e++) {
+        if (factorization.rodTypes.at(e) == RodType::Rope) {
+            double angle = model.getRodAngle(e);
+            ropes.append({e, cos(angle), sin(angle), model.rodE.at(e) * model.rodA.at(e) / model.getRodLength(e)});
+        }
+    }
+    iterations = 0;
+    slackRopes.resize(U_a.cols());
+    if (ropes.isEmpty()) {
+        for (QVector<int> &slack : slackRopes) {
+            slack.clear();
+        }
+        return "";
+    }
+    InverseEntries inverse;
+    for (int column = 0; column < U_a.cols(); column++) {
+        // the ropes that were slack in this column the last time are the first guess, everything else of the guess is ignored
+        QVector<int> slack;
+        for (int e : slackRopes.at(column)) {
+            if (e >= 0 && e < model.getRodCount() && factorization.rodTypes.at(e) == RodType::Rope) {
+                slack.append(e);
+            }
+        }
+        std::sort(slack.begin(), slack.end());
+        slack.erase(std::unique(slack.begin(), slack.end()), slack.end());
+
+        const Eigen::VectorXd y = U_a.col(column); // every rope active
+        const Eigen::VectorXd f = F_a_reduced.col(column);
+        double scale = f.size() > 0 ? f.cwiseAbs().maxCoeff() : 0;
+        for (const RopeData &rope : ropes) {
+            scale = fmax(scale, fabs(determineRopeForce(factorization, rope, y, U_b, column)));
+        }
+        double tolerance = relativeForceTolerance * scale;
+        Eigen::VectorXd u;
+        for (int iteration = 1; ; iteration++) {
+            auto status = solveWithoutSlackRopes(factorization, slack, y, f, inverse, u);
+            if (status != "") {
+                return status;
+            }
+            // remove every compressed rope and add every slack rope again that would be elongated, all at once
+            QVector<int> newSlack;
+            for (const RopeData &rope : ropes) {
+                double force = determineRopeForce(factorization, rope, u, U_b, column);
+                bool isSlack = std::binary_search(slack.begin(), slack.end(), rope.rod);
+                if (isSlack ? force <= tolerance : force < - tolerance) {
+                    newSlack.append(rope.rod); // ascending, because the ropes are sorted by their rod-index
+                }
+            }
+            if (newSlack == slack) {
+                iterations = qMax(iterations, iteration);
+                break;
+            }
+            if (iteration == maxIterations) {
+                return "the slack ropes did not settle within " + QString::number(maxIterations) + " iterations";
+            }
+            slack = newSlack;
+        }
+        U_a.col(column) = u;
+        slackRopes[column] = slack;
+    }
+    return "";
+}
+
+void TensionOnly::removeSlackRopes(const FactorizationCache &factorization, const QVector<QVector<int>> &slackRopes, const Eigen::MatrixXd &U, Eigen::MatrixXd &F,
+                                   Eigen::MatrixXd &innerForces)
+{
+    const PartitionedSystem &system = factorization.system;
+    for (int column = 0; column < qMin(slackRopes.size(), static_cast<int>(U.cols())); column++) {
+        for (int e : slackRopes.at(column)) {
+            const QVector<int> &dof = factorization.coincidenceTable.at(e);
+            Eigen::VectorXd u_e(dof.size());
+            for (int i = 0; i < dof.size(); i++) {
+                u_e(i) = U(dof.at(i), column);
+            }
+            Eigen::VectorXd f_e = factorization.elementMatrices.at(e) * u_e;
+            for (int i = 0; i < dof.size(); i++) {
+                if (!system.isFree(dof.at(i))) { // the free dofs hold the applied loads, they do not change
+                    F(dof.at(i), column) -= f_e(i);
+                }
+            }
+            innerForces(e, column) = 0;
+        }
+    }
+}
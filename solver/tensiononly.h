@@ -0,0 +1,27 @@
+#ifndef TENSIONONLY_H
+#define TENSIONONLY_H
+
+#include "calculator.h"
+
+#include <QString>
+#include <QVector>
+
+class FactorizationCache;
+
+// ropes can not carry compression: a compressed rope is slack, its ESM is removed from K and the system is solved again until no active rope is compressed and
+// no slack rope would be elongated (active-set iteration), every column of the right-hand-side (load-case) has its own set of slack ropes
+// K_aa is not factorized again, the removed ESMs are a low-rank correction (sherman-morrison-woodbury) on top of the cached factorization (see FactorizationCache),
+// the columns of K_aa^-1 * P are computed once per dof and reused by all iterations and columns
+namespace TensionOnly
+{
+    // U_a holds the solution with every rope active (K_aa^-1 * F_a_reduced) and gets replaced by the solution without the slack ropes
+    // slackRopes holds the slack ropes of every column, its input is the first guess (e.g. the slack ropes of the last solve() while a node gets dragged)
+    QString solve(const TrussModel &model, const FactorizationCache &factorization, const Eigen::MatrixXd &F_a_reduced, const Eigen::MatrixXd &U_b,
+                  Eigen::MatrixXd &U_a, QVector<QVector<int>> &slackRopes, int &iterations);
+
+    // innerForces and the reaction-forces in F were determined as if every rope were active, this removes the forces of the slack ropes from them
+    void removeSlackRopes(const FactorizationCache &factorization, const QVector<QVector<int>> &slackRopes, const Eigen::MatrixXd &U, Eigen::MatrixXd &F,
+                          Eigen::MatrixXd &innerForces);
+}
+
+#endif // TENSIONONLY_H
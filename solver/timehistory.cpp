@@ -0,0 +1,215 @@
+#include "solver/timehistory.h"
+
+#include "solver/elementtraits.h"
+#include "solver/factorizationcache.h"
+#include "solver/lanczos.h"
+#include "solver/modal.h"
+#include "solver/partitionedsystem.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // the time of a step may differ from the equidistant one by this fraction of the time-step (round-off of the times in the load-history)
+    const double timeTolerance = 1e-6;
+
+    // the normal-forces are linear in U_a (see Calculator::determineInnerForces(), the prescribed dofs are 0), one sparse product per time-step gives all of them
+    Eigen::SparseMatrix<double> determineForceMatrix(const TrussModel &model, const FactorizationCache &factorization)
+    {
+        const PartitionedSystem &system = factorization.system;
+        QVector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(4 * model.getRodCount());
+        auto add = [&](int e, int dof, double value) {
+            if (system.isFree(dof)) {
+                triplets.append(Eigen::Triplet<double>(e, system.getLocalIndex(dof), value));
+            }
+        };
+        for (int e = 0; e < model.getRodCount(); e++) {
+            const QVector<int> &dof = factorization.coincidenceTable.at(e);
+            double angle = model.getRodAngle(e);
+            double k = model.rodE.at(e) * model.rodA.at(e) / model.getRodLength(e);
+            visitRodType(factorization.rodTypes.at(e), [&](auto traits) {
+                typedef decltype(traits) Traits;
+                for (int n = 0; n < 2; n++) {
+                    double sign = n == 0 ? -1 : 1; // u2 - u1, positive if the rod gets longer
+                    add(e, dof.at(Traits::x(n)), sign * k * cos(angle));
+                    add(e, dof.at(Traits::y(n)), - sign * k * sin(angle)); // - because the y-axis is downwards positive
+                }
+            });
+        }
+        Eigen::SparseMatrix<double> N(model.getRodCount(), system.getFreeDofs().size());
+        N.setFromTriplets(triplets.begin(), triplets.end());
+        return N;
+    }
+} // end anonymous namespace
+
+QString TimeHistory::solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, const Settings &historySettings,
+                           const LoadReader &readStep, const StepWriter &writeStep, Result &result)
+{
+    result = Result();
+    const PartitionedSystem &system = factorization.system;
+    int dofCount = factorization.dofCount;
+    int rodCount = model.getRodCount();
+    int loadCaseCount = model.getLoadCaseCount();
+    double alpha = historySettings.alpha;
+    if (!(alpha >= -1.0 / 3 && alpha <= 0)) {
+        return "the alpha of the HHT-method has to be in [-1/3, 0]";
+    }
+    if (!(historySettings.dampingRatio >= 0)) {
+        return "the damping-ratio must not be negative";
+    }
+    if (factorization.solver == nullptr || factorization.solver->isSingular()) {
+        return "the time-history analysis needs a stable system, the stiffness-matrix is singular";
+    }
+
+    // the load-cases as columns of the free dofs, the loads of a time-step are their sum with the factors of the step
+    Eigen::MatrixXd F = Eigen::MatrixXd::Zero(dofCount, loadCaseCount);
+    Eigen::VectorXb F_k = Eigen::VectorXb::Constant(dofCount, false);
+    Eigen::MatrixXd U = Eigen::MatrixXd::Zero(dofCount, loadCaseCount);
+    Eigen::VectorXb U_k = Eigen::VectorXb::Constant(dofCount, false);
+    auto status = Calculator::applyConstraints(model, factorization.nodeFirstDof, factorization.nodeDofCount, F, F_k, U, U_k);
+    if (status != "") {
+        return status;
+    }
+    Eigen::SparseMatrix<double> loadCases = system.getF_a(F).sparseView();
+
+    // the first two steps give the time-step, the effective stiffness depends on it
+    double time = 0;
+    double startTime = 0;
+    Eigen::VectorXd factors;
+    bool atEnd = false;
+    auto read = [&]() -> QString {
+        auto status = readStep(time, factors, atEnd);
+        if (status == "" && !atEnd && factors.size() != loadCaseCount) {
+            status = "every time-step needs one load-factor per load-case";
+        }
+        return status;
+    };
+    status = read();
+    if (status != "") {
+        return status;
+    }
+    startTime = time;
+    Eigen::VectorXd F_old = atEnd ? Eigen::VectorXd() : Eigen::VectorXd(loadCases * factors);
+    if (!atEnd) {
+        status = read();
+        if (status != "") {
+            return status;
+        }
+    }
+    if (atEnd) {
+        return "the load-history needs at least two time-steps";
+    }
+    double dt = time - startTime;
+    if (!(dt > 0)) {
+        return "the times of the load-history have to increase";
+    }
+    result.timeStep = dt;
+
+    Eigen::SparseMatrix<double> M_aa;
+    status = Modal::assembleMassMatrix(model, settings, factorization, M_aa);
+    if (status != "") {
+        return status;
+    }
+    // rayleigh-damping: the damping-ratio of the frequency omega is massDamping / (2 * omega) + stiffnessDamping * omega / 2, it equals dampingRatio at omega_1 and omega_2
+    if (historySettings.dampingRatio > 0) {
+        auto applyInverse = [&](const Eigen::VectorXd &b) -> Eigen::VectorXd { // K_aa^-1 * b
+            return factorization.solve(b);
+        };
+        Eigen::VectorXd mu;
+        Eigen::MatrixXd phi_a;
+        if (!Lanczos::solve(factorization.K_aa, M_aa, applyInverse, 2, mu, phi_a)) {
+            return "the natural frequencies of the rayleigh-damping did not converge";
+        }
+        if (mu.size() == 0) {
+            return "the rayleigh-damping needs masses, but every rod has the density 0";
+        }
+        double omega1 = 1 / sqrt(mu(0));
+        double omega2 = 1 / sqrt(mu(mu.size() - 1)); // with only one natural frequency both terms damp it by half of the ratio
+        result.massDamping = 2 * historySettings.dampingRatio * omega1 * omega2 / (omega1 + omega2);
+        result.stiffnessDamping = 2 * historySettings.dampingRatio / (omega1 + omega2);
+    }
+
+    // HHT: M * a_n+1 + (1 + alpha) * (C * v_n+1 + K * u_n+1) - alpha * (C * v_n + K * u_n) = (1 + alpha) * F_n+1 - alpha * F_n
+    // with the newmark-relations a_n+1 = c_M * u_n+1 - p and v_n+1 = c_C * u_n+1 - q (p and q only depend on step n) this is K_eff * u_n+1 = R
+    double beta = (1 - alpha) * (1 - alpha) / 4;
+    double gamma = 0.5 - alpha;
+    double c_M = 1 / (beta * dt * dt);
+    double c_C = gamma / (beta * dt);
+    double a_M = result.massDamping;
+    double a_K = result.stiffnessDamping;
+    Eigen::SparseMatrix<double> K_eff = (1 + alpha) * (1 + c_C * a_K) * factorization.K_aa + (c_M + (1 + alpha) * c_C * a_M) * M_aa;
+    // same backend as the linear K (see Calculator::factorizeSystem()), K_eff has the pattern of K_aa, therefore it inherits its ordering as well
+    LinearSolver solver(settings.solverBackend, settings.dofOrdering != DofOrdering::Natural);
+    if (dofCount > settings.sparseAssemblyThreshold) {
+        solver.factorize(K_eff);
+    } else {
+        solver.factorize(Eigen::MatrixXd(K_eff));
+    }
+    if (solver.isSingular()) {
+        return "the effective stiffness-matrix of the time-history analysis is singular";
+    }
+
+    // the system starts at rest in the static equilibrium of the first loads (then M * a + C * v + K * u = F holds at the start as well)
+    Eigen::VectorXd u = factorization.solve(F_old).col(0);
+    Eigen::VectorXd v = Eigen::VectorXd::Zero(u.size());
+    Eigen::VectorXd a = Eigen::VectorXd::Zero(u.size());
+    Eigen::SparseMatrix<double> N = determineForceMatrix(model, factorization);
+    const QVector<int> &freeDofs = system.getFreeDofs();
+    Eigen::VectorXd U_step = Eigen::VectorXd::Zero(dofCount); // the prescribed dofs stay 0
+    const double infinity = std::numeric_limits<double>::infinity();
+    result.minU = Eigen::VectorXd::Constant(dofCount, infinity);
+    result.maxU = Eigen::VectorXd::Constant(dofCount, - infinity);
+    result.minInnerForces = Eigen::VectorXd::Constant(rodCount, infinity);
+    result.maxInnerForces = Eigen::VectorXd::Constant(rodCount, - infinity);
+    result.minInnerForceTimes = Eigen::VectorXd::Zero(rodCount);
+    result.maxInnerForceTimes = Eigen::VectorXd::Zero(rodCount);
+    auto write = [&](double stepTime) -> QString { // keeps the peaks and passes the step on
+        for (int i = 0; i < freeDofs.size(); i++) {
+            U_step(freeDofs.at(i)) = u(i);
+        }
+        Eigen::VectorXd innerForces = N * u;
+        result.minU = result.minU.cwiseMin(U_step);
+        result.maxU = result.maxU.cwiseMax(U_step);
+        for (int e = 0; e < rodCount; e++) {
+            if (innerForces(e) < result.minInnerForces(e)) {
+                result.minInnerForces(e) = innerForces(e);
+                result.minInnerForceTimes(e) = stepTime;
+            }
+            if (innerForces(e) > result.maxInnerForces(e)) {
+                result.maxInnerForces(e) = innerForces(e);
+                result.maxInnerForceTimes(e) = stepTime;
+            }
+        }
+        result.steps++;
+        return writeStep(stepTime, U_step, innerForces);
+    };
+    status = write(startTime);
+    if (status != "") {
+        return status;
+    }
+
+    for (int step = 1; !atEnd; step++) {
+        if (fabs(time - (startTime + step * dt)) > timeTolerance * dt) {
+            return "the times of the load-history have to be equidistant (time-step " + QString::number(step) + ")";
+        }
+        Eigen::VectorXd F_new = loadCases * factors;
+        Eigen::VectorXd p = c_M * u + v / (beta * dt) + (1 / (2 * beta) - 1) * a;
+        Eigen::VectorXd q = c_C * u + (gamma / beta - 1) * v + dt * (gamma / (2 * beta) - 1) * a;
+        Eigen::VectorXd w = (1 + alpha) * q + alpha * v; // the damping-forces of the right-hand-side are C * w
+        Eigen::VectorXd R = (1 + alpha) * F_new - alpha * F_old + M_aa * (p + a_M * w) + factorization.K_aa * (alpha * u + a_K * w);
+        u = solver.solve(R).col(0);
+        a = c_M * u - p;
+        v = c_C * u - q;
+        F_old = F_new;
+        status = write(time);
+        if (status == "") {
+            status = read();
+        }
+        if (status != "") {
+            return status;
+        }
+    }
+    return "";
+}
@@ -0,0 +1,49 @@
+#ifndef TIMEHISTORY_H
+#define TIMEHISTORY_H
+
+#include "calculator.h"
+
+#include <QString>
+
+#include <functional>
+
+class FactorizationCache;
+
+// transient dynamics: M * a + C * v + K * u = F(t), integrated with the HHT-alpha method (alpha = 0: newmark average acceleration, the trapezoidal rule)
+// the loads are the load-cases of the model, each scaled by its own factor over time (see LoadReader), M comes from the densities like in solver/modal.h
+// K is the one of the linear solve() (every rope is taut), the effective stiffness K + c_C * C + c_M * M is factorized once, then every time-step only needs sparse
+// matrix-vector-products and one forward/back-substitution
+// the steps are read and written one after the other (e.g. from and to a file), only the peaks of the results are kept in memory
+namespace TimeHistory
+{
+    struct Settings
+    {
+        double alpha = 0; // HHT-alpha in [-1/3, 0], < 0 damps the highest (mesh-dependent) frequencies numerically, beta and gamma follow from it
+        double dampingRatio = 0; // rayleigh-damping C = massDamping * M + stiffnessDamping * K with this ratio at the two lowest natural frequencies
+    };
+
+    struct Result
+    {
+        int steps = 0; // written time-steps including the one at the start
+        double timeStep = 0; // [s]
+        double massDamping = 0; // [1/s]
+        double stiffnessDamping = 0; // [s]
+        Eigen::VectorXd minU; // peaks over all time-steps, one entry per dof
+        Eigen::VectorXd maxU;
+        Eigen::VectorXd minInnerForces; // one entry per rod
+        Eigen::VectorXd maxInnerForces;
+        Eigen::VectorXd minInnerForceTimes; // [s], time of the first occurrence of the peak
+        Eigen::VectorXd maxInnerForceTimes;
+    };
+
+    // reads the next time-step: its time [s] and one factor per load-case, atEnd is set to true (and the rest ignored) if there are no more steps
+    typedef std::function<QString(double &time, Eigen::VectorXd &factors, bool &atEnd)> LoadReader;
+    // gets the results of one time-step: U with one entry per dof (like one column of Solution::U) and the normal-forces of the rods
+    typedef std::function<QString(double time, const Eigen::VectorXd &U, const Eigen::VectorXd &innerForces)> StepWriter;
+
+    // the times have to be equidistant, the system starts at rest in the static equilibrium of the loads of the first time-step
+    QString solve(const TrussModel &model, const Calculator::SolverSettings &settings, const FactorizationCache &factorization, const Settings &historySettings,
+                  const LoadReader &readStep, const StepWriter &writeStep, Result &result);
+}
+
+#endif // TIMEHISTORY_H
@@ -0,0 +1,78 @@
+#include "trussmodel.h"
+
+#include <cmath>
+
+int TrussModel::addNode(double x, double y, NodeType type)
+{
+    nodeX.append(x);
+    nodeY.append(y);
+    nodeType.append(type);
+    nodeHasBearing.append(false);
+    nodeBearingType.append(BearingType::LocatingBearing);
+    for (int loadCase = 0; loadCase < getLoadCaseCount(); loadCase++) {
+        nodeFx.append(0);
+        nodeFy.append(0);
+        nodeMz.append(0);
+    }
+    return nodeX.size() - 1;
+}
+
+int TrussModel::addRod(int node1, int node2, double E, double A, double I, double rho, RodType type)
+{
+    rodNode1.append(node1);
+    rodNode2.append(node2);
+    rodE.append(E);
+    rodA.append(A);
+    rodI.append(I);
+    rodRho.append(rho);
+    rodType.append(type);
+    return rodNode1.size() - 1;
+}
+
+void TrussModel::setBearing(int node, BearingType type)
+{
+    nodeHasBearing[node] = true;
+    nodeBearingType[node] = type;
+}
+
+void TrussModel::setLoadCases(const QStringList &names)
+{
+    // the loads are stored node by node, therefore they have to be copied into arrays with the new stride
+    int oldCount = getLoadCaseCount();
+    int newCount = names.size();
+    auto restride = [this, oldCount, newCount](QVector<double> &loads) {
+        QVector<double> newLoads(getNodeCount() * newCount, 0);
+        for (int node = 0; node < getNodeCount(); node++) {
+            for (int loadCase = 0; loadCase < qMin(oldCount, newCount); loadCase++) {
+                newLoads[node * newCount + loadCase] = loads.at(node * oldCount + loadCase);
+            }
+        }
+        loads = newLoads;
+    };
+    restride(nodeFx);
+    restride(nodeFy);
+    restride(nodeMz);
+    loadCaseNames = names;
+}
+
+void TrussModel::addLoad(int node, double fx, double fy, double mz, int loadCase)
+{
+    int index = getLoadIndex(node, loadCase);
+    nodeFx[index] += fx;
+    nodeFy[index] += fy;
+    nodeMz[index] += mz;
+}
+
+double TrussModel::getRodLength(int rod) const
+{
+    double dx = nodeX.at(rodNode2.at(rod)) - nodeX.at(rodNode1.at(rod));
+    double dy = nodeY.at(rodNode2.at(rod)) - nodeY.at(rodNode1.at(rod));
+    return sqrt(dx * dx + dy * dy); // sqrt(dx² + dy²)
+}
+
+double TrussModel::getRodAngle(int rod) const // same as Rod::getAngle(), the value is within [-pi; +pi]
+{
+    double dx = nodeX.at(rodNode2.at(rod)) - nodeX.at(rodNode1.at(rod));
+    double dy = nodeY.at(rodNode2.at(rod)) - nodeY.at(rodNode1.at(rod));
+    return atan2(- dy, dx); // because the y-axis is downwards positive
+}
@@ -0,0 +1,56 @@
+#ifndef TRUSSMODEL_H
+#define TRUSSMODEL_H
+
+#include "elements/elementtypes.h"
+
+#include <QStringList>
+#include <QVector>
+
+struct LoadCombination // factored sum of load-cases, e.g. 1.35 * G + 1.5 * Q
+{
+    QString name;
+    QVector<double> factors; // one factor per load-case, 0 if the load-case is not part of the combination (missing factors count as 0 as well)
+};
+
+// plain-data snapshot of a truss, every property is stored in a contiguous array with one entry per node (rod), the index of a node (rod) is its calc-id
+// it holds no ptrs to graphics-items, therefore the calculator can use it on any thread and without a scene
+struct TrussModel
+{
+    int addNode(double x, double y, NodeType type); // [m], returns the index of the new node
+    int addRod(int node1, int node2, double E, double A, double I, double rho, RodType type = RodType::Beam); // returns the index of the new rod
+    void setBearing(int node, BearingType type);
+    void setLoadCases(const QStringList &names); // a model has one load-case by default, loads already applied keep the index of their load-case
+    void addLoad(int node, double fx, double fy, double mz, int loadCase = 0); // adds to the loads already applied to the node in this load-case
+
+    int getNodeCount() const { return nodeX.size(); }
+    int getRodCount() const { return rodNode1.size(); }
+    double getRodLength(int rod) const; // [m]
+    double getRodAngle(int rod) const; // [rad]
+    int getLoadCaseCount() const { return loadCaseNames.size(); }
+    int getLoadIndex(int node, int loadCase) const { return node * loadCaseNames.size() + loadCase; } // index into nodeFx, nodeFy and nodeMz
+
+    // load-cases, every load-case is solved with the same stiffness, only the applied loads differ
+    QStringList loadCaseNames{"Lastfall 1"};
+    QVector<LoadCombination> loadCombinations; // only combine the results, the system is not solved for them
+
+    // nodes, the coords have the y-axis downwards positive (same as in the scene)
+    QVector<double> nodeX; // [m]
+    QVector<double> nodeY; // [m]
+    QVector<NodeType> nodeType;
+    QVector<bool> nodeHasBearing;
+    QVector<BearingType> nodeBearingType; // only valid if nodeHasBearing is true
+    QVector<double> nodeFx; // resulting applied force [N], positive: right; one entry per node and load-case, see getLoadIndex()
+    QVector<double> nodeFy; // resulting applied force [N], positive: up
+    QVector<double> nodeMz; // resulting applied moment [Nm], positive: counterclockwise
+
+    // rods
+    QVector<int> rodNode1; // node-indices
+    QVector<int> rodNode2;
+    QVector<double> rodE; // young's modulus [N/m²]
+    QVector<double> rodA; // cross-section area [m²]
+    QVector<double> rodI; // area-moment of inertia [m^4]
+    QVector<double> rodRho; // density [kg/m³], only the modal analysis uses it
+    QVector<RodType> rodType; // beam or rope, the calculator decides if a beam is computed as a bar (see Calculator::determineRodTypes())
+};
+
+#endif // TRUSSMODEL_H
@@ -0,0 +1,179 @@
+#include "spatialindex.h"
+
+#include "elements/trusselement.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    const qint64 maxCellsPerElement = 256; // elements covering more cells are kept in a separate list
+}
+
+SpatialIndex::SpatialIndex(double cellSize) :
+    cellSize(cellSize),
+    nextOrder(0)
+{
+
+}
+
+void SpatialIndex::insert(TrussElement *element)
+{
+    entries[element].order = nextOrder++; // if the element is already registered (e.g. it got a new parent) only its order is renewed, like Qt does with the sibling-index
+    dirtyElements.insert(element);
+}
+
+void SpatialIndex::remove(TrussElement *element)
+{
+    auto it = entries.find(element);
+    if (it == entries.end()) {
+        return;
+    }
+    removeFromCells(element, it.value());
+    entries.erase(it);
+    dirtyElements.remove(element);
+}
+
+void SpatialIndex::markDirty(TrussElement *element)
+{
+    if (entries.contains(element)) { // elements that are not registered (yet) are ignored, they are marked as dirty when they get inserted
+        dirtyElements.insert(element);
+    }
+}
+
+QList<TrussElement *> SpatialIndex::getElements(const QPointF &point)
+{
+    update();
+    QList<TrussElement *> list;
+    auto appendIfHit = [&list, &point](TrussElement *element) {
+        // the cells only hold the bounding-rects, the exact test is done with the shape of the element; hidden elements (e.g. forces of other load-cases) are skipped like in QGraphicsScene::items()
+        if (element->isVisible() && element->contains(element->mapFromScene(point))) {
+            list.append(element);
+        }
+    };
+    auto it = cells.constFind(cellKey(cellCoordinate(point.x()), cellCoordinate(point.y())));
+    if (it != cells.constEnd()) {
+        for (TrussElement *element : it.value()) {
+            appendIfHit(element);
+        }
+    }
+    for (TrussElement *element : oversizedElements) {
+        appendIfHit(element);
+    }
+    return list;
+}
+
+bool SpatialIndex::isAbove(const QGraphicsItem *item1, const QGraphicsItem *item2) const // port of the item-comparison Qt uses for the stacking order
+{
+    if (item1->parentItem() == item2->parentItem()) {
+        return isAboveSibling(item1, item2);
+    }
+    auto depth = [](const QGraphicsItem *item) {
+        int d = 0;
+        while ((item = item->parentItem()) != nullptr) {
+            d++;
+        }
+        return d;
+    };
+    int depth1 = depth(item1);
+    int depth2 = depth(item2);
+    // walk up until both items are on the same level, if one item is the ancestor of the other the child is above unless it stacks behind its parent
+    const QGraphicsItem *ancestor1 = item1;
+    while (depth1 > depth2) {
+        if (ancestor1->parentItem() == item2) {
+            return !(ancestor1->flags() & QGraphicsItem::ItemStacksBehindParent);
+        }
+        ancestor1 = ancestor1->parentItem();
+        depth1--;
+    }
+    const QGraphicsItem *ancestor2 = item2;
+    while (depth2 > depth1) {
+        if (ancestor2->parentItem() == item1) {
+            return ancestor2->flags() & QGraphicsItem::ItemStacksBehindParent;
+        }
+        ancestor2 = ancestor2->parentItem();
+        depth2--;
+    }
+    // walk up until the ancestors are siblings (or top-level-items) and compare those
+    while (ancestor1->parentItem() != ancestor2->parentItem()) {
+        ancestor1 = ancestor1->parentItem();
+        ancestor2 = ancestor2->parentItem();
+    }
+    return isAboveSibling(ancestor1, ancestor2);
+}
+
+void SpatialIndex::update()
+{
+    for (TrussElement *element : dirtyElements) {
+        Entry &entry = entries[element];
+        removeFromCells(element, entry);
+        QRectF rect = element->sceneBoundingRect();
+        QRect range(QPoint(cellCoordinate(rect.left()), cellCoordinate(rect.top())), QPoint(cellCoordinate(rect.right()), cellCoordinate(rect.bottom())));
+        bool finite = std::isfinite(rect.left()) && std::isfinite(rect.top()) && std::isfinite(rect.right()) && std::isfinite(rect.bottom());
+        qint64 cellCount = (static_cast<qint64>(range.right()) - range.left() + 1) * (static_cast<qint64>(range.bottom()) - range.top() + 1);
+        if (!finite || cellCount > maxCellsPerElement) {
+            entry.oversized = true;
+            oversizedElements.insert(element);
+            continue;
+        }
+        for (int x = range.left(); x <= range.right(); x++) {
+            for (int y = range.top(); y <= range.bottom(); y++) {
+                cells[cellKey(x, y)].append(element);
+            }
+        }
+        entry.cells = range;
+    }
+    dirtyElements.clear();
+}
+
+void SpatialIndex::removeFromCells(TrussElement *element, Entry &entry)
+{
+    if (entry.oversized) {
+        oversizedElements.remove(element);
+        entry.oversized = false;
+        return;
+    }
+    for (int x = entry.cells.left(); x <= entry.cells.right(); x++) { // does nothing if the range is invalid
+        for (int y = entry.cells.top(); y <= entry.cells.bottom(); y++) {
+            auto it = cells.find(cellKey(x, y));
+            if (it == cells.end()) {
+                continue;
+            }
+            QVector<TrussElement *> &cell = it.value();
+            int index = cell.indexOf(element);
+            if (index != -1) { // the order within a cell does not matter, therefore swap with the last element and pop it
+                cell[index] = cell.last();
+                cell.removeLast();
+            }
+            if (cell.isEmpty()) {
+                cells.erase(it);
+            }
+        }
+    }
+    entry.cells = QRect();
+}
+
+int SpatialIndex::cellCoordinate(double value) const
+{
+    double cell = std::floor(value / cellSize);
+    if (!(cell > std::numeric_limits<int>::min() / 2)) { // also catches NaN
+        return std::numeric_limits<int>::min() / 2;
+    }
+    if (cell > std::numeric_limits<int>::max() / 2) {
+        return std::numeric_limits<int>::max() / 2;
+    }
+    return static_cast<int>(cell);
+}
+
+bool SpatialIndex::isAboveSibling(const QGraphicsItem *item1, const QGraphicsItem *item2) const
+{
+    bool behind1 = item1->flags() & QGraphicsItem::ItemStacksBehindParent;
+    bool behind2 = item2->flags() & QGraphicsItem::ItemStacksBehindParent;
+    if (behind1 != behind2) {
+        return behind2;
+    }
+    if (!Utilities::isequal(item1->zValue(), item2->zValue())) {
+        return item1->zValue() > item2->zValue();
+    }
+    return entries.value(item1).order > entries.value(item2).order; // the element inserted later is drawn above
+}
@@ -0,0 +1,50 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QPointF>
+#include <QRect>
+#include <QSet>
+#include <QVector>
+
+class QGraphicsItem;
+class TrussElement;
+
+// uniform grid over the scene-bounding-rects of the elements, used for hit-testing instead of looping over all items of the scene
+// the elements register/unregister themselves and mark themselves as dirty when their geometry changes, the grid-cells are updated lazily on the next query
+class SpatialIndex
+{
+public:
+    explicit SpatialIndex(double cellSize = 64.0); // cellSize is in [px]
+
+    void insert(TrussElement *element);
+    void remove(TrussElement *element);
+    void markDirty(TrussElement *element); // call this whenever the scene-bounding-rect of the element might have changed
+
+    QList<TrussElement *> getElements(const QPointF &point); // point is in scene-coords, returns all visible elements whose shape contains the point in no particular order
+    bool isAbove(const QGraphicsItem *item1, const QGraphicsItem *item2) const; // returns true if item1 is drawn above item2 (same stacking order as QGraphicsScene::items())
+
+private:
+    struct Entry
+    {
+        QRect cells; // range of cells the element is stored in (invalid if the element is not stored in any cell yet)
+        bool oversized = false; // element covers too many cells and is therefore stored in oversizedElements
+        quint64 order = 0; // insertion-order, used like the sibling-index of Qt to sort elements with equal z-values
+    };
+
+    void update(); // moves all dirty elements into the cells that match their current scene-bounding-rect
+    void removeFromCells(TrussElement *element, Entry &entry);
+    static quint64 cellKey(int x, int y) { return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y); }
+    int cellCoordinate(double value) const;
+    bool isAboveSibling(const QGraphicsItem *item1, const QGraphicsItem *item2) const;
+
+    double cellSize;
+    quint64 nextOrder;
+    QHash<quint64, QVector<TrussElement *>> cells;
+    QHash<const QGraphicsItem *, Entry> entries;
+    QSet<TrussElement *> dirtyElements;
+    QSet<TrussElement *> oversizedElements; // e.g. very long rods, checked on every query instead of being stored in thousands of cells
+};
+
+#endif // SPATIALINDEX_H
@@ -0,0 +1,34 @@
+#-------------------------------------------------
+#
+# Headless batch-solver for truss-files saved by TrussCalculator (needs no display)
+#
+#-------------------------------------------------
+
+QT       += core concurrent
+QT       -= gui
+
+TARGET = trusscalc-cli
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS _USE_MATH_DEFINES
+
+CONFIG += c++14 \
+        console \
+        object_parallel_to_source
+CONFIG -= app_bundle
+
+CONFIG(release): CONFIG += -O3
+
+include(solver/solver.pri)
+
+SOURCES += \
+    cli/historyfiles.cpp \
+    cli/main.cpp \
+    cli/resultwriter.cpp \
+    cli/trussfile.cpp
+
+HEADERS += \
+    cli/historyfiles.h \
+    cli/resultwriter.h \
+    cli/trussfile.h \
+    jsonkeys.h
@@ -19,7 +19,8 @@ RodDialog::RodDialog(QWidget *parent, Rod *elementRod) :
     u2zLabel(new QLabel(QString::number(elementRod->getU(3)), this)), // parent is this
     EInput(new LineEdit(QString::number(elementRod->getE()), this)), // parent is this
     AInput(new LineEdit(QString::number(elementRod->getA()), this)), // parent is this
-    IInput(new LineEdit(QString::number(elementRod->getI()), this)) // parent is this
+    IInput(new LineEdit(QString::number(elementRod->getI()), this)), // parent is this
+    rhoInput(new LineEdit(QString::number(elementRod->getDensity()), this)) // parent is this
 {
     auto layout = new QGridLayout(); // parent gets set later
     layout->addWidget(new QLabel("Elastizitätsmodul [N/m²]:", this), 0, 0); // parent of the label is this
@@ -31,20 +32,23 @@ RodDialog::RodDialog(QWidget *parent, Rod *elementRod) :
     layout->addWidget(new QLabel("Flächenträgheitsmoment y [m<sup>4</sup>]:", this), 2, 0);
     connectLineEdit(IInput, this, &RodDialog::setI);
     layout->addWidget(IInput, 2, 1);
-    layout->addWidget(new QLabel("Größe der Normalkraft [N]:", this), 3, 0);
-    layout->addWidget(rodForceLabel, 3, 1);
-    layout->addWidget(new QLabel(QString("x-Verschiebung Knoten ") + rod->getNode1()->getId() + QString(" [m]:"), this), 4, 0);
-    layout->addWidget(u1xLabel, 4, 1);
-    layout->addWidget(new QLabel(QString("y-Verschiebung Knoten ") + rod->getNode1()->getId() + QString(" [m]:"), this), 5, 0);
-    layout->addWidget(u1yLabel, 5, 1);
-    layout->addWidget(new QLabel(QString("z-Verdrehung Knoten ") + rod->getNode1()->getId() + QString(" [rad]:"), this), 6, 0);
-    layout->addWidget(u1zLabel, 6, 1);
-    layout->addWidget(new QLabel(QString("x-Verschiebung Knoten ") + rod->getNode2()->getId() + QString(" [m]:"), this), 7, 0);
-    layout->addWidget(u2xLabel, 7, 1);
-    layout->addWidget(new QLabel(QString("y-Verschiebung Knoten ") + rod->getNode2()->getId() + QString(" [m]:"), this), 8, 0);
-    layout->addWidget(u2yLabel, 8, 1);
-    layout->addWidget(new QLabel(QString("z-Verdrehung Knoten ") + rod->getNode2()->getId() + QString(" [rad]:"), this), 9, 0);
-    layout->addWidget(u2zLabel, 9, 1);
+    layout->addWidget(new QLabel("Dichte [kg/m³]:", this), 3, 0);
+    connectLineEdit(rhoInput, this, &RodDialog::setDensity);
+    layout->addWidget(rhoInput, 3, 1);
+    layout->addWidget(new QLabel("Größe der Normalkraft [N]:", this), 4, 0);
+    layout->addWidget(rodForceLabel, 4, 1);
+    layout->addWidget(new QLabel(QString("x-Verschiebung Knoten ") + rod->getNode1()->getId() + QString(" [m]:"), this), 5, 0);
+    layout->addWidget(u1xLabel, 5, 1);
+    layout->addWidget(new QLabel(QString("y-Verschiebung Knoten ") + rod->getNode1()->getId() + QString(" [m]:"), this), 6, 0);
+    layout->addWidget(u1yLabel, 6, 1);
+    layout->addWidget(new QLabel(QString("z-Verdrehung Knoten ") + rod->getNode1()->getId() + QString(" [rad]:"), this), 7, 0);
+    layout->addWidget(u1zLabel, 7, 1);
+    layout->addWidget(new QLabel(QString("x-Verschiebung Knoten ") + rod->getNode2()->getId() + QString(" [m]:"), this), 8, 0);
+    layout->addWidget(u2xLabel, 8, 1);
+    layout->addWidget(new QLabel(QString("y-Verschiebung Knoten ") + rod->getNode2()->getId() + QString(" [m]:"), this), 9, 0);
+    layout->addWidget(u2yLabel, 9, 1);
+    layout->addWidget(new QLabel(QString("z-Verdrehung Knoten ") + rod->getNode2()->getId() + QString(" [rad]:"), this), 10, 0);
+    layout->addWidget(u2zLabel, 10, 1);
     connect(okButton, &QPushButton::clicked, this, &EasyChangeDialog::okPressed);
     layout->addWidget(okButton, 0, 2);
     setLayout(layout); // reparents all above created widgets and layouts to this->centralWidget()
@@ -71,11 +75,23 @@ void RodDialog::setI()
     rod->setI(IInput->text().toDouble());
 }
 
+void RodDialog::setDensity()
+{
+    bool ok;
+    double density = rhoInput->text().toDouble(&ok);
+    if (ok && Rod::isValidDensity(density)) {
+        rod->setDensity(density);
+    } else {
+        rhoInput->setText(QString::number(rod->getDensity())); // reject the input
+    }
+}
+
 void RodDialog::okPressed(bool)
 {
     setE();
     setA();
     setI();
+    setDensity();
     rod->closeEasyChangeDialog(); // close dialog via element
 }
 
@@ -91,4 +107,5 @@ void RodDialog::updateDialog()
     EInput->setText(QString::number(rod->getE()));
     AInput->setText(QString::number(rod->getA()));
     IInput->setText(QString::number(rod->getI()));
+    rhoInput->setText(QString::number(rod->getDensity()));
 }
@@ -24,6 +24,7 @@ public:
     void setE();
     void setA();
     void setI();
+    void setDensity();
 
 private:
     Rod *rod; // weak ptr
@@ -37,6 +38,7 @@ private:
     LineEdit *EInput; // parent is this
     LineEdit *AInput; // parent is this
     LineEdit *IInput; // parent is this
+    LineEdit *rhoInput; // parent is this
 
     // EasyChangeDialog interface
 public:
@@ -33,6 +33,7 @@ public:
 
     void toggleNodeAdder(bool checked);
     void toggleRodAdder(bool checked);
+    void toggleRopeAdder(bool checked);
     void toggleBearingAdder(bool checked);
     void toggleForceAdder(bool checked);
     void toggleDimensionAdder(bool checked);
@@ -0,0 +1,60 @@
+#include "loadcombinationdialog.h"
+
+#include "solver/loadcombination.h"
+
+#include <QVBoxLayout>
+#include <QPlainTextEdit>
+#include <QLabel>
+#include <QDialogButtonBox>
+#include <QPushButton>
+
+LoadCombinationDialog::LoadCombinationDialog(const QVector<LoadCombination> &combinations, const QStringList &loadCaseNames, QWidget *parent) :
+    QDialog(parent, Qt::CustomizeWindowHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint),
+    loadCaseNames(loadCaseNames),
+    loadCombinations(combinations),
+    textEdit(new QPlainTextEdit(this)),
+    errorLabel(new QLabel(this))
+{
+    setWindowTitle("Lastfallkombinationen");
+    QStringList lines;
+    for (const LoadCombination &combination : combinations) {
+        lines.append(Combination::toString(combination, loadCaseNames));
+    }
+    textEdit->setPlainText(lines.join('\n'));
+    textEdit->setPlaceholderText("z.B. GZT = 1.35 * " + loadCaseNames.first() + (loadCaseNames.size() > 1 ? " + 1.5 * " + loadCaseNames.at(1) : QString()));
+    textEdit->setMinimumSize(500, 250);
+    errorLabel->setStyleSheet("color: red");
+    errorLabel->hide();
+
+    QVBoxLayout *layout = new QVBoxLayout(); // gets reparented later
+    layout->addWidget(new QLabel("Eine Kombination pro Zeile (Name = Faktor * Lastfall + ...), Lastfälle: " + loadCaseNames.join(", "), this)); // parent is this
+    layout->addWidget(textEdit);
+    layout->addWidget(errorLabel);
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this); // parent is this
+    buttons->button(QDialogButtonBox::Cancel)->setText("Abbrechen");
+    connect(buttons, &QDialogButtonBox::accepted, this, &LoadCombinationDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &LoadCombinationDialog::reject);
+    layout->addWidget(buttons);
+    setLayout(layout); // dialog takes ownership of layout
+}
+
+void LoadCombinationDialog::accept()
+{
+    QVector<LoadCombination> combinations;
+    QStringList lines = textEdit->toPlainText().split('\n');
+    for (int i = 0; i < lines.size(); i++) {
+        if (lines.at(i).trimmed().isEmpty()) {
+            continue;
+        }
+        LoadCombination combination;
+        QString status = Combination::parse(lines.at(i), loadCaseNames, combination);
+        if (status != "") {
+            errorLabel->setText("Zeile " + QString::number(i + 1) + ": " + status);
+            errorLabel->show();
+            return;
+        }
+        combinations.append(combination);
+    }
+    loadCombinations = combinations;
+    QDialog::accept();
+}
@@ -0,0 +1,32 @@
+#ifndef LOADCOMBINATIONDIALOG_H
+#define LOADCOMBINATIONDIALOG_H
+
+#include "solver/trussmodel.h"
+
+#include <QDialog>
+
+class QPlainTextEdit;
+class QLabel;
+
+// edits the load-combinations as text, one combination per line, e.g. "ULS = 1.35 * G + 1.5 * Q"
+class LoadCombinationDialog final : public QDialog
+{
+    Q_OBJECT
+
+public:
+    LoadCombinationDialog(const QVector<LoadCombination> &combinations, const QStringList &loadCaseNames, QWidget *parent = nullptr);
+
+    QVector<LoadCombination> getLoadCombinations() const { return loadCombinations; } // valid after the dialog was accepted
+
+    // QDialog interface
+public slots:
+    void accept() override; // only closes the dialog if every line is a valid combination
+
+private:
+    QStringList loadCaseNames;
+    QVector<LoadCombination> loadCombinations;
+    QPlainTextEdit *textEdit; // has this as parent
+    QLabel *errorLabel; // has this as parent
+};
+
+#endif // LOADCOMBINATIONDIALOG_H
@@ -10,6 +10,7 @@
 #include "elements/rod.h"
 #include "jsonkeys.h"
 #include "widgets/seteaiglobaldialog.h"
+#include "widgets/loadcombinationdialog.h"
 
 #include <QMouseEvent>
 #include <QDebug>
@@ -23,6 +24,8 @@
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
 #include <QIcon>
+#include <QInputDialog>
+#include <QSignalBlocker>
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
@@ -30,17 +33,24 @@ MainWindow::MainWindow(QWidget *parent) :
     toolBar(nullptr),
     actionToggleNodeAdder(nullptr),
     actionToggleRodAdder(nullptr),
+    actionToggleRopeAdder(nullptr),
     actionToggleBearingAdder(nullptr),
     actionToggleForceAdder(nullptr),
     actionToggleDimensionAdder(nullptr),
     actionToggleLabelAdder(nullptr),
+    loadCaseToolBar(nullptr),
+    loadCaseInput(new QComboBox()), // gets reparented later
+    resultInput(new QComboBox()), // gets reparented later
+    modeShapeInput(new QComboBox()), // gets reparented later
     colorRods(false),
     markZeroLoadingRods(false),
     showRodNumbers(false),
     drawDeformedSystem(false),
     openFilePath(""),
     statusBarMinForceLabel(new QLabel("0 N")), // gets reparented later
-    statusBarMaxForceLabel(new QLabel("0 N")) // gets reparented later
+    statusBarMaxForceLabel(new QLabel("0 N")), // gets reparented later
+    statusBarSolverLabel(new QLabel("")), // gets reparented later
+    statusBarOrderingLabel(new QLabel("")) // gets reparented later
 {
     ui->setupUi(this);
     auto graphicsScene = new GraphicsScene(this); // gets deleted when this is dtored
@@ -51,6 +61,8 @@ MainWindow::MainWindow(QWidget *parent) :
 
     // setup status-bar
     setStatusBar(new QStatusBar(this)); // gets deleted when this is destroyed
+    statusBar()->addPermanentWidget(statusBarOrderingLabel); // the label gets reparented to the status-bar
+    statusBar()->addPermanentWidget(statusBarSolverLabel); // the label gets reparented to the status-bar
     statusBar()->addPermanentWidget(statusBarMinForceLabel); // the label gets reparented to the status-bar
     QLabel *colorIcon = new QLabel();
     colorIcon->setPixmap(QPixmap(":/rodcolorscale.png"));
@@ -76,6 +88,13 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(actionToggleRodAdder, &QAction::toggled, this, &MainWindow::toggleRodAdder);
     toolBar->addAction(actionToggleRodAdder);
 
+    actionToggleRopeAdder = new QAction(this); // parent is this
+    actionToggleRopeAdder->setIcon(QIcon(":/ropeicon.png"));
+    actionToggleRopeAdder->setToolTip("Seile hinzufügen (nur zugfest)");
+    actionToggleRopeAdder->setCheckable(true);
+    connect(actionToggleRopeAdder, &QAction::toggled, this, &MainWindow::toggleRopeAdder);
+    toolBar->addAction(actionToggleRopeAdder);
+
     actionToggleBearingAdder = new QAction(this); // parent is this
     actionToggleBearingAdder->setIcon(QIcon(":/bearingicon.png"));
     actionToggleBearingAdder->setToolTip("Lager hinzufügen");
@@ -106,7 +125,42 @@ MainWindow::MainWindow(QWidget *parent) :
 
     addToolBar(Qt::LeftToolBarArea, toolBar);
 
+    // setup load-case-tool-bar, the forces of all load-cases are solved together, the selected one is shown
+    loadCaseToolBar = new QToolBar(this); // gets deleted when this is dtor-ed
+    loadCaseToolBar->setContextMenuPolicy(Qt::PreventContextMenu);
+    loadCaseToolBar->addWidget(new QLabel("Lastfall: ")); // the label gets reparented to the tool-bar
+    loadCaseInput->setMinimumContentsLength(16);
+    loadCaseInput->setToolTip("Angezeigter Lastfall, neue Kräfte werden diesem Lastfall zugeordnet");
+    loadCaseToolBar->addWidget(loadCaseInput); // loadCaseInput gets reparented to the tool-bar
+    connect(loadCaseInput, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        ui->graphicsView->getGraphicsScene()->setActiveLoadCase(index);
+    });
+    loadCaseToolBar->addAction("Neu", this, &MainWindow::addLoadCase)->setToolTip("Lastfall hinzufügen");
+    loadCaseToolBar->addAction("Umbenennen", this, &MainWindow::renameLoadCase)->setToolTip("Angezeigten Lastfall umbenennen");
+    loadCaseToolBar->addAction("Löschen", this, &MainWindow::removeLoadCase)->setToolTip("Angezeigten Lastfall samt seinen Kräften löschen");
+    loadCaseToolBar->addSeparator();
+    loadCaseToolBar->addWidget(new QLabel("Ergebnis: "));
+    resultInput->setMinimumContentsLength(16);
+    resultInput->setToolTip("Angezeigtes Ergebnis: der angezeigte Lastfall, eine Lastfallkombination oder die Umhüllende aller Kombinationen");
+    loadCaseToolBar->addWidget(resultInput); // resultInput gets reparented to the tool-bar
+    connect(resultInput, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        ui->graphicsView->getGraphicsScene()->setShownResult(resultInput->itemData(index).toInt());
+    });
+    loadCaseToolBar->addAction("Kombinationen...", this, &MainWindow::editLoadCombinations)->setToolTip("Lastfallkombinationen bearbeiten");
+    loadCaseToolBar->addSeparator();
+    loadCaseToolBar->addWidget(new QLabel("Eigenform: "));
+    modeShapeInput->setMinimumContentsLength(20);
+    modeShapeInput->setToolTip("Die verformten Stäbe zeigen eine Knickfigur zum Lastfaktor (Verzweigungslast = Lastfaktor · Lasten des angezeigten Ergebnisses) "
+                               "oder eine Schwingform zur Eigenfrequenz, die Anzahl der Knick- und Schwingformen wird in den Einstellungen festgelegt");
+    modeShapeInput->addItem("keine", GraphicsScene::showDeformation);
+    loadCaseToolBar->addWidget(modeShapeInput); // modeShapeInput gets reparented to the tool-bar
+    connect(modeShapeInput, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        ui->graphicsView->getGraphicsScene()->setShownModeShape(modeShapeInput->itemData(index).toInt());
+    });
+    addToolBar(Qt::TopToolBarArea, loadCaseToolBar);
+
     ui->graphicsView->setScene(graphicsScene); // view does not take ownership of scene
+    updateLoadCases();
 }
 
 MainWindow::~MainWindow()
@@ -119,6 +173,8 @@ void MainWindow::toggleNodeAdder(bool checked)
     if (checked) {
         if (actionToggleRodAdder->isChecked()) {
             actionToggleRodAdder->setChecked(false);
+        } else if (actionToggleRopeAdder->isChecked()) {
+            actionToggleRopeAdder->setChecked(false);
         } else if (actionToggleBearingAdder->isChecked()) {
             actionToggleBearingAdder->setChecked(false);
         } else if (actionToggleForceAdder->isChecked()) {
@@ -137,6 +193,8 @@ void MainWindow::toggleRodAdder(bool checked)
     if (checked) {
         if (actionToggleNodeAdder->isChecked()) {
             actionToggleNodeAdder->setChecked(false);
+        } else if (actionToggleRopeAdder->isChecked()) {
+            actionToggleRopeAdder->setChecked(false);
         } else if (actionToggleBearingAdder->isChecked()) {
             actionToggleBearingAdder->setChecked(false);
         } else if (actionToggleForceAdder->isChecked()) {
@@ -150,6 +208,26 @@ void MainWindow::toggleRodAdder(bool checked)
     ui->graphicsView->toggleRodAdder(checked);
 }
 
+void MainWindow::toggleRopeAdder(bool checked)
+{
+    if (checked) {
+        if (actionToggleNodeAdder->isChecked()) {
+            actionToggleNodeAdder->setChecked(false);
+        } else if (actionToggleRodAdder->isChecked()) {
+            actionToggleRodAdder->setChecked(false);
+        } else if (actionToggleBearingAdder->isChecked()) {
+            actionToggleBearingAdder->setChecked(false);
+        } else if (actionToggleForceAdder->isChecked()) {
+            actionToggleForceAdder->setChecked(false);
+        } else if (actionToggleDimensionAdder->isChecked()) {
+            actionToggleDimensionAdder->setChecked(false);
+        } else if (actionToggleLabelAdder->isChecked()) {
+            actionToggleLabelAdder->setChecked(false);
+        }
+    }
+    ui->graphicsView->toggleRopeAdder(checked);
+}
+
 void MainWindow::toggleBearingAdder(bool checked)
 {
     if (checked) {
@@ -157,6 +235,8 @@ void MainWindow::toggleBearingAdder(bool checked)
             actionToggleNodeAdder->setChecked(false);
         } else if (actionToggleRodAdder->isChecked()) {
             actionToggleRodAdder->setChecked(false);
+        } else if (actionToggleRopeAdder->isChecked()) {
+            actionToggleRopeAdder->setChecked(false);
         } else if (actionToggleForceAdder->isChecked()) {
             actionToggleForceAdder->setChecked(false);
         } else if (actionToggleDimensionAdder->isChecked()) {
@@ -175,6 +255,8 @@ void MainWindow::toggleForceAdder(bool checked)
             actionToggleNodeAdder->setChecked(false);
         } else if (actionToggleRodAdder->isChecked()) {
             actionToggleRodAdder->setChecked(false);
+        } else if (actionToggleRopeAdder->isChecked()) {
+            actionToggleRopeAdder->setChecked(false);
         } else if (actionToggleBearingAdder->isChecked()) {
             actionToggleBearingAdder->setChecked(false);
         } else if (actionToggleDimensionAdder->isChecked()) {
@@ -193,6 +275,8 @@ void MainWindow::toggleDimensionAdder(bool checked)
             actionToggleNodeAdder->setChecked(false);
         } else if (actionToggleRodAdder->isChecked()) {
             actionToggleRodAdder->setChecked(false);
+        } else if (actionToggleRopeAdder->isChecked()) {
+            actionToggleRopeAdder->setChecked(false);
         } else if (actionToggleBearingAdder->isChecked()) {
             actionToggleBearingAdder->setChecked(false);
         } else if (actionToggleForceAdder->isChecked()) {
@@ -211,6 +295,8 @@ void MainWindow::toggleLabelAdder(bool checked)
             actionToggleNodeAdder->setChecked(false);
         } else if (actionToggleRodAdder->isChecked()) {
             actionToggleRodAdder->setChecked(false);
+        } else if (actionToggleRopeAdder->isChecked()) {
+            actionToggleRopeAdder->setChecked(false);
         } else if (actionToggleBearingAdder->isChecked()) {
             actionToggleBearingAdder->setChecked(false);
         } else if (actionToggleForceAdder->isChecked()) {
@@ -238,12 +324,59 @@ void MainWindow::updateRodColorMinMaxValue(double minValue, double maxValue)
     statusBarMaxForceLabel->setText(QString::number(maxValue) + " N");
 }
 
+void MainWindow::updateSolverBackend(const QString &backend)
+{
+    statusBarSolverLabel->setText("Löser: " + backend);
+}
+
+void MainWindow::updateDofOrdering(const QString &ordering, const QString &metrics)
+{
+    statusBarOrderingLabel->setText(ordering + ": " + metrics); // metrics before and after the reordering
+}
+
+void MainWindow::updateLoadCases()
+{
+    GraphicsScene *scene = ui->graphicsView->getGraphicsScene();
+    QSignalBlocker blocker(loadCaseInput); // refilling the combo-box must not change the active load-case of the scene
+    loadCaseInput->clear();
+    loadCaseInput->addItems(scene->getLoadCases());
+    loadCaseInput->setCurrentIndex(scene->getActiveLoadCase());
+    QSignalBlocker resultBlocker(resultInput);
+    resultInput->clear();
+    resultInput->addItem("Lastfall", GraphicsScene::showActiveLoadCase); // the item-data is the value of the shown result of the scene
+    QVector<LoadCombination> combinations = scene->getLoadCombinations();
+    for (int c = 0; c < combinations.size(); c++) {
+        resultInput->addItem(combinations.at(c).name, c);
+    }
+    if (!combinations.isEmpty()) {
+        resultInput->addItem("Umhüllende", GraphicsScene::showEnvelope);
+    }
+    resultInput->setCurrentIndex(resultInput->findData(scene->getShownResult()));
+}
+
+void MainWindow::updateModeShapes(const QVector<double> &loadFactors, const QVector<double> &frequencies, int shownMode)
+{
+    QSignalBlocker blocker(modeShapeInput); // refilling the combo-box must not change the shown mode of the scene
+    modeShapeInput->clear();
+    modeShapeInput->addItem("keine", GraphicsScene::showDeformation);
+    for (int mode = 0; mode < loadFactors.size(); mode++) {
+        modeShapeInput->addItem("Knicken " + QString::number(mode + 1) + ": η = " + QString::number(loadFactors.at(mode), 'g', 4), mode);
+    }
+    for (int mode = 0; mode < frequencies.size(); mode++) { // the natural modes follow the buckling modes, see GraphicsScene::setShownModeShape()
+        modeShapeInput->addItem("Schwingung " + QString::number(mode + 1) + ": f = " + QString::number(frequencies.at(mode), 'g', 4) + " Hz", loadFactors.size() + mode);
+    }
+    int index = modeShapeInput->findData(shownMode);
+    modeShapeInput->setCurrentIndex(index != -1 ? index : 0); // the scene keeps its mode, it gets shown again as soon as the solution has enough modes
+}
+
 void MainWindow::quitAddingElements() const
 {
     if (actionToggleNodeAdder->isChecked()) {
         actionToggleNodeAdder->setChecked(false);
     } else if (actionToggleRodAdder->isChecked()) {
         actionToggleRodAdder->setChecked(false);
+    } else if (actionToggleRopeAdder->isChecked()) {
+        actionToggleRopeAdder->setChecked(false);
     } else if (actionToggleBearingAdder->isChecked()) {
         actionToggleBearingAdder->setChecked(false);
     } else if (actionToggleForceAdder->isChecked()) {
@@ -293,6 +426,60 @@ QByteArray MainWindow::createSaveFileContent() const // create a json-representa
     return document.toJson(QJsonDocument::Indented); // return document
 }
 
+void MainWindow::addLoadCase()
+{
+    GraphicsScene *scene = ui->graphicsView->getGraphicsScene();
+    bool ok = false;
+    QString name = QInputDialog::getText(this, "Neuer Lastfall", "Name:", QLineEdit::Normal, "Lastfall " + QString::number(scene->getLoadCases().size() + 1), &ok);
+    if (!ok || name.isEmpty()) {
+        return;
+    }
+    int loadCase = scene->addLoadCase(name);
+    updateLoadCases();
+    loadCaseInput->setCurrentIndex(loadCase); // show the new load-case, so that the next forces are added to it
+}
+
+void MainWindow::renameLoadCase()
+{
+    GraphicsScene *scene = ui->graphicsView->getGraphicsScene();
+    int loadCase = scene->getActiveLoadCase();
+    bool ok = false;
+    QString name = QInputDialog::getText(this, "Lastfall umbenennen", "Name:", QLineEdit::Normal, scene->getLoadCases().at(loadCase), &ok);
+    if (!ok || name.isEmpty()) {
+        return;
+    }
+    scene->renameLoadCase(loadCase, name);
+    updateLoadCases();
+}
+
+void MainWindow::removeLoadCase()
+{
+    GraphicsScene *scene = ui->graphicsView->getGraphicsScene();
+    if (scene->getLoadCases().size() <= 1) {
+        QMessageBox::information(this, "Hinweis:", "Der letzte Lastfall kann nicht gelöscht werden.");
+        return;
+    }
+    int loadCase = scene->getActiveLoadCase();
+    if (QMessageBox::question(this, "Achtung:", "Soll der Lastfall \"" + scene->getLoadCases().at(loadCase) + "\" samt seinen Kräften gelöscht werden?")
+            != QMessageBox::Yes) {
+        return;
+    }
+    quitAddingElements();
+    scene->removeLoadCase(loadCase);
+    updateLoadCases();
+}
+
+void MainWindow::editLoadCombinations()
+{
+    GraphicsScene *scene = ui->graphicsView->getGraphicsScene();
+    LoadCombinationDialog dialog(scene->getLoadCombinations(), scene->getLoadCases(), this);
+    if (dialog.exec() != QDialog::Accepted) {
+        return;
+    }
+    scene->setLoadCombinations(dialog.getLoadCombinations());
+    updateLoadCases();
+}
+
 void MainWindow::mousePressEvent(QMouseEvent *event)
 {
     QMainWindow::mousePressEvent(event);
@@ -312,6 +499,7 @@ void MainWindow::on_action_New_triggered() // create new file
     auto graphicsScene = new GraphicsScene(this); // parent is this
     // display the scene
     ui->graphicsView->setScene(graphicsScene);
+    updateLoadCases();
     // clear the openFilePath
     openFilePath = "";
 }
@@ -337,6 +525,7 @@ void MainWindow::on_action_Open_triggered() // open file
     QString version = root.value(JsonKeys::version).toString();
     if (version == "1.0") { // version is supported
         ui->graphicsView->loadFromJson(root.value(JsonKeys::graphicsView).toObject(), this); // let the graphicsView load the other values
+        updateLoadCases();
     } else { // version is not supported, error
         QMessageBox::critical(this, "Fehler:", "Die Protokollversion der zu öffnenden Datei wird in dieser Version des Fachwerkrechners nicht unterstützt!");
         return;
@@ -536,6 +725,6 @@ void MainWindow::on_action_drawDeformedSystem_triggered(bool checked)
 void MainWindow::on_actionDefineEAIglobal_triggered()
 {
     quitAddingElements();
-    SetEAIGlobalDialog d(static_cast<GraphicsScene *>(ui->graphicsView->scene()), this); // open dialog to change E, A, I
+    SetEAIGlobalDialog d(static_cast<GraphicsScene *>(ui->graphicsView->scene()), this); // open dialog to change E, A, I, rho
     d.exec();
 }
@@ -3,6 +3,8 @@
 
 #include <QMainWindow>
 #include <QLabel>
+#include <QComboBox>
+#include <QVector>
 
 class GraphicsView;
 
@@ -25,6 +27,7 @@ public:
 
     void toggleNodeAdder(bool checked);
     void toggleRodAdder(bool checked);
+    void toggleRopeAdder(bool checked);
     void toggleBearingAdder(bool checked);
     void toggleForceAdder(bool checked);
     void toggleDimensionAdder(bool checked);
@@ -36,6 +39,10 @@ public:
 
     void setStatusBarMessage(const QString &message); // call with empty string to clear the status bar message
     void updateRodColorMinMaxValue(double minValue, double maxValue);
+    void updateSolverBackend(const QString &backend);
+    void updateDofOrdering(const QString &ordering, const QString &metrics);
+    void updateLoadCases(); // fills the load-case- and result-selection with the load-cases and load-combinations of the current scene
+    void updateModeShapes(const QVector<double> &loadFactors, const QVector<double> &frequencies, int shownMode); // fills the mode-shape-selection with the last solution
 
     bool getColorRods() const { return colorRods; }
     bool getMarkZeroLoadingRods() const { return markZeroLoadingRods; }
@@ -50,14 +57,24 @@ private:
 
     QByteArray createSaveFileContent() const;
 
+    void addLoadCase();
+    void renameLoadCase();
+    void removeLoadCase();
+    void editLoadCombinations();
+
     Ui::MainWindow *ui; // deleted in dtor
     QToolBar *toolBar; // has this as parent
     QAction *actionToggleNodeAdder; // has this as parent
     QAction *actionToggleRodAdder; // has this as parent
+    QAction *actionToggleRopeAdder; // has this as parent
     QAction *actionToggleBearingAdder; // has this as parent
     QAction *actionToggleForceAdder; // has this as parent
     QAction *actionToggleDimensionAdder; // has this as parent
     QAction *actionToggleLabelAdder; // has this as parent
+    QToolBar *loadCaseToolBar; // has this as parent
+    QComboBox *loadCaseInput; // gets reparented to loadCaseToolBar
+    QComboBox *resultInput; // gets reparented to loadCaseToolBar
+    QComboBox *modeShapeInput; // gets reparented to loadCaseToolBar
     bool colorRods; // indicates if the rods should be colored relative to the size of their rod-force
     bool markZeroLoadingRods; // indicates if zero-loading-rods should be marked
     bool showNodeNumbers;
@@ -66,6 +83,8 @@ private:
     QString openFilePath;
     QLabel *statusBarMinForceLabel; // gets reparented to this->statusBar()
     QLabel *statusBarMaxForceLabel; // gets reparented to this->statusBar()
+    QLabel *statusBarSolverLabel; // gets reparented to this->statusBar()
+    QLabel *statusBarOrderingLabel; // gets reparented to this->statusBar()
 
 private slots:
     void on_action_New_triggered();
@@ -30,6 +30,11 @@ void SetEAIGlobalDialog::on_okButton_clicked()
         if (ui->IBox->isChecked()) {
             rod->setI(ui->IInput->text().toDouble());
         }
+        bool ok;
+        double density = ui->rhoInput->text().toDouble(&ok);
+        if (ui->rhoBox->isChecked() && ok && Rod::isValidDensity(density)) { // an invalid density keeps the one of the rods
+            rod->setDensity(density);
+        }
     }
     close();
 }
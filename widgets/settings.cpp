@@ -5,9 +5,13 @@
 #include "utilities.h"
 #include "widgets/graphicsview.h"
 #include "graphicsscene.h"
+#include "solver/linearsolver.h"
+#include "solver/dofordering.h"
+#include "calculator.h"
 
 #include <QFormLayout>
 #include <QPushButton>
+#include <QComboBox>
 
 void Settings::setSceneWidth()
 {
@@ -34,13 +38,73 @@ void Settings::setDisplacementCalculationStep()
     static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setDisplacementCalculationStep(displacementCalculationStepInput->text().toDouble());
 }
 
+void Settings::setSparseAssemblyThreshold()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setSparseAssemblyThreshold(sparseAssemblyThresholdInput->text().toInt());
+}
+
+void Settings::setSolverBackend()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setSolverBackend(static_cast<SolverBackend>(solverBackendInput->currentIndex()));
+}
+
+void Settings::setDofOrdering()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setDofOrdering(static_cast<DofOrdering>(dofOrderingInput->currentIndex()));
+}
+
+void Settings::setMaxLowRankUpdates()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setMaxLowRankUpdates(maxLowRankUpdatesInput->text().toInt());
+}
+
+void Settings::setAnalysisType()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setAnalysisType(static_cast<AnalysisType>(analysisTypeInput->currentIndex()));
+}
+
+void Settings::setThreadCount()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setThreadCount(threadCountInput->text().toInt());
+}
+
+void Settings::setLoadSteps()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setLoadSteps(loadStepsInput->text().toInt());
+}
+
+void Settings::setBucklingModes()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setBucklingModes(bucklingModesInput->text().toInt());
+}
+
+void Settings::setNaturalModes()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setNaturalModes(naturalModesInput->text().toInt());
+}
+
+void Settings::setMassMatrix()
+{
+    static_cast<GraphicsScene *>(static_cast<MainWindow *>(parent())->getGraphicsView()->scene())->setMassMatrix(static_cast<MassMatrix>(massMatrixInput->currentIndex()));
+}
+
 Settings::Settings(MainWindow *parent) :
     QDialog(parent, Qt::CustomizeWindowHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint),
     sceneWidthInput(new LineEdit(QString::number(parent->getGraphicsView()->getMinSceneWidth()), this)),
     sceneHeightInput(new LineEdit(QString::number(parent->getGraphicsView()->getMinSceneHeight()), this)),
     scaleValueInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getScaleValue()), this)),
     maxDisplacementDistanceInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getMaxDisplacementDistance()), this)),
-    displacementCalculationStepInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getDisplacementCalculationStep()), this))
+    displacementCalculationStepInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getDisplacementCalculationStep()), this)),
+    sparseAssemblyThresholdInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getSparseAssemblyThreshold()), this)),
+    solverBackendInput(new QComboBox(this)),
+    dofOrderingInput(new QComboBox(this)),
+    maxLowRankUpdatesInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getMaxLowRankUpdates()), this)),
+    analysisTypeInput(new QComboBox(this)),
+    threadCountInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getThreadCount()), this)),
+    loadStepsInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getLoadSteps()), this)),
+    bucklingModesInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getBucklingModes()), this)),
+    naturalModesInput(new LineEdit(QString::number(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getNaturalModes()), this)),
+    massMatrixInput(new QComboBox(this))
 {
     setWindowTitle("Einstellungen");
 
@@ -56,6 +120,38 @@ Settings::Settings(MainWindow *parent) :
     formLayout->addRow("Maximal gezeichnete Auslenkung [px]:", maxDisplacementDistanceInput);
     connectLineEdit(displacementCalculationStepInput, &Settings::setDisplacementCalculationStep);
     formLayout->addRow("Schrittwert bei der Deformationszeichnung [%]:", displacementCalculationStepInput);
+    connectLineEdit(sparseAssemblyThresholdInput, &Settings::setSparseAssemblyThreshold);
+    formLayout->addRow("Dünnbesetzte Steifigkeitsmatrix ab Freiheitsgraden:", sparseAssemblyThresholdInput);
+    for (auto backend : {SolverBackend::Automatic, SolverBackend::SparseLDLT, SolverBackend::SparseLLT, SolverBackend::DenseLDLT, SolverBackend::DenseCOD}) {
+        solverBackendInput->addItem(LinearSolver::toString(backend)); // the index of an item equals the value of the backend
+    }
+    solverBackendInput->setCurrentIndex(static_cast<int>(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getSolverBackend()));
+    formLayout->addRow("Gleichungslöser:", solverBackendInput);
+    for (auto ordering : {DofOrdering::Natural, DofOrdering::ReverseCuthillMcKee, DofOrdering::ApproximateMinimumDegree, DofOrdering::NestedDissection}) {
+        dofOrderingInput->addItem(Ordering::toString(ordering)); // the index of an item equals the value of the ordering
+    }
+    dofOrderingInput->setCurrentIndex(static_cast<int>(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getDofOrdering()));
+    formLayout->addRow("Nummerierung der Freiheitsgrade:", dofOrderingInput);
+    connectLineEdit(maxLowRankUpdatesInput, &Settings::setMaxLowRankUpdates);
+    formLayout->addRow("Rang-Korrekturen beim Verschieben bis zur Neufaktorisierung:", maxLowRankUpdatesInput);
+    for (auto type : {AnalysisType::Automatic, AnalysisType::Frame, AnalysisType::Truss}) {
+        analysisTypeInput->addItem(Calculator::toString(type)); // the index of an item equals the value of the analysis-type
+    }
+    analysisTypeInput->setCurrentIndex(static_cast<int>(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getAnalysisType()));
+    formLayout->addRow("Berechnungsmodell (im Projekt gespeichert):", analysisTypeInput);
+    connectLineEdit(threadCountInput, &Settings::setThreadCount);
+    formLayout->addRow("Threads für Elementmatrizen und Assemblierung (0: alle Kerne):", threadCountInput);
+    connectLineEdit(loadStepsInput, &Settings::setLoadSteps);
+    formLayout->addRow("Laststufen Theorie II. Ordnung (0: linear, im Projekt gespeichert):", loadStepsInput);
+    connectLineEdit(bucklingModesInput, &Settings::setBucklingModes);
+    formLayout->addRow("Knickfiguren des angezeigten Ergebnisses (0: keine, im Projekt gespeichert):", bucklingModesInput);
+    connectLineEdit(naturalModesInput, &Settings::setNaturalModes);
+    formLayout->addRow("Eigenfrequenzen und Schwingformen (0: keine, im Projekt gespeichert):", naturalModesInput);
+    for (auto type : {MassMatrix::Consistent, MassMatrix::Lumped}) {
+        massMatrixInput->addItem(Calculator::toString(type)); // the index of an item equals the value of the mass-matrix
+    }
+    massMatrixInput->setCurrentIndex(static_cast<int>(static_cast<GraphicsScene *>(parent->getGraphicsView()->scene())->getMassMatrix()));
+    formLayout->addRow("Massenmatrix der Stäbe (im Projekt gespeichert):", massMatrixInput);
 
     // create button-area
     QHBoxLayout *hBoxLayout = new QHBoxLayout(); // gets reparented later
@@ -89,5 +185,15 @@ void Settings::okButtonClicked() // save contents of line-edits
     scaleValueInput->returnPressed();
     maxDisplacementDistanceInput->returnPressed();
     displacementCalculationStepInput->returnPressed();
+    sparseAssemblyThresholdInput->returnPressed();
+    maxLowRankUpdatesInput->returnPressed();
+    threadCountInput->returnPressed();
+    loadStepsInput->returnPressed();
+    bucklingModesInput->returnPressed();
+    naturalModesInput->returnPressed();
+    setSolverBackend(); // the combo-box has no editing-done-signal, therefore apply its value only when ok is pressed
+    setDofOrdering();
+    setAnalysisType();
+    setMassMatrix();
     close();
 }
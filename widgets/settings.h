@@ -4,6 +4,7 @@
 #include <QDialog>
 
 class LineEdit;
+class QComboBox;
 class MainWindow;
 
 class Settings : public QDialog
@@ -23,6 +24,16 @@ public:
     void setScaleValue();
     void setMaxDisplacementDistance();
     void setDisplacementCalculationStep();
+    void setSparseAssemblyThreshold();
+    void setSolverBackend();
+    void setDofOrdering();
+    void setMaxLowRankUpdates();
+    void setAnalysisType();
+    void setThreadCount();
+    void setLoadSteps();
+    void setBucklingModes();
+    void setNaturalModes();
+    void setMassMatrix();
 
 private:
     void connectLineEdit(LineEdit *lineEdit, void (Settings::*slot)()); // provided to reduce writing in this class
@@ -33,6 +44,16 @@ private:
     LineEdit *scaleValueInput; // parent is this
     LineEdit *maxDisplacementDistanceInput; // parent is this
     LineEdit *displacementCalculationStepInput; // parent is this
+    LineEdit *sparseAssemblyThresholdInput; // parent is this
+    QComboBox *solverBackendInput; // parent is this
+    QComboBox *dofOrderingInput; // parent is this
+    LineEdit *maxLowRankUpdatesInput; // parent is this
+    QComboBox *analysisTypeInput; // parent is this
+    LineEdit *threadCountInput; // parent is this
+    LineEdit *loadStepsInput; // parent is this
+    LineEdit *bucklingModesInput; // parent is this
+    LineEdit *naturalModesInput; // parent is this
+    QComboBox *massMatrixInput; // parent is this
 };
 
 #endif // SETTINGS_H
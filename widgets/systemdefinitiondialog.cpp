@@ -18,18 +18,34 @@
 
 SystemDefinitionDialog::SystemDefinitionDialog(GraphicsScene *graphicsScene, QWidget *parent) :
     QDialog(parent, Qt::CustomizeWindowHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint),
-    ui(new Ui::SystemDefinitionDialog)
+    ui(new Ui::SystemDefinitionDialog),
+    showEnvelope(!graphicsScene->getLoadCombinations().isEmpty())
 {
     ui->setupUi(this);
 
     setWindowTitle("Systemdefinition");
 
     ui->tabWidget->setTabText(0, "Knoten");
-    setupTable<Node>(ui->nodeView, graphicsScene->items(), QStringList{"ID", "Knotenart", "x-Position [m]", "y-Position [m]", "x-Verschiebung [m]", "y-Verschiebung [m]"});
+    QStringList nodeLabels{"ID", "Knotenart", "x-Position [m]", "y-Position [m]", "x-Verschiebung [m]", "y-Verschiebung [m]"};
+    if (showEnvelope) {
+        nodeLabels << "min x-Verschiebung [m]" << "max x-Verschiebung [m]" << "min y-Verschiebung [m]" << "max y-Verschiebung [m]";
+    }
+    setupTable<Node>(ui->nodeView, graphicsScene->items(), nodeLabels);
     ui->tabWidget->setTabText(1, "Stäbe");
-    setupTable<Rod>(ui->rodView, graphicsScene->items(), QStringList{"ID", "Knoten 1-ID", "Knoten 2-ID", "E [N/m²]", "A [m²]", "Iy [m^4]", "Normalkraft [N]", "x-Verschiebung 1 [m]", "y-Verschiebung 1 [m]", "z-Verdrehung 1 [rad]", "x-Verschiebung 2 [m]", "y-Verschiebung 2 [m]", "z-Verdrehung 2 [rad]"});
+    QStringList rodLabels{"ID", "Knoten 1-ID", "Knoten 2-ID", "E [N/m²]", "A [m²]", "Iy [m^4]", "ρ [kg/m³]", "Normalkraft [N]", "x-Verschiebung 1 [m]", "y-Verschiebung 1 [m]", "z-Verdrehung 1 [rad]", "x-Verschiebung 2 [m]", "y-Verschiebung 2 [m]", "z-Verdrehung 2 [rad]"};
+    if (showEnvelope) {
+        rodLabels << "min Normalkraft [N]" << "max Normalkraft [N]";
+    }
+    setupTable<Rod>(ui->rodView, graphicsScene->items(), rodLabels);
+    ui->rodView->setEditTriggers(QTableView::DoubleClicked | QTableView::EditKeyPressed); // only the density-column is editable, see populateModel()
+    connect(static_cast<QStandardItemModel *>(ui->rodView->model()), &QStandardItemModel::itemChanged, this, &SystemDefinitionDialog::rodItemChanged);
     ui->tabWidget->setTabText(2, "Lager");
-    setupTable<Bearing>(ui->bearingView, graphicsScene->items(), QStringList{"ID", "Knoten-ID", "Lagerart", "Winkel [°]", "Lagerreaktion x [N]", "Lagerreaktion y [N]", "Reaktionsmoment z [Nm]"});
+    QStringList bearingLabels{"ID", "Knoten-ID", "Lagerart", "Winkel [°]", "Lagerreaktion x [N]", "Lagerreaktion y [N]", "Reaktionsmoment z [Nm]"};
+    if (showEnvelope) {
+        bearingLabels << "min Lagerreaktion x [N]" << "max Lagerreaktion x [N]" << "min Lagerreaktion y [N]" << "max Lagerreaktion y [N]" << "min Reaktionsmoment z [Nm]"
+                      << "max Reaktionsmoment z [Nm]";
+    }
+    setupTable<Bearing>(ui->bearingView, graphicsScene->items(), bearingLabels);
     ui->tabWidget->setTabText(3, "Kräfte");
     setupTable<SingleForce>(ui->forceView, graphicsScene->items(), QStringList{"ID", "Knoten-ID", "Wert [N]", "Winkel [°]"});
 
@@ -51,11 +67,19 @@ void SystemDefinitionDialog::populateModel(QStandardItemModel *model, QList<Node
         model->setItem(i, 3, new QStandardItem(QString::number(- list.at(i)->y() / static_cast<GraphicsScene *>(list.at(i)->scene())->getScaleValue()))); // flip y-axis
         model->setItem(i, 4, new QStandardItem(QString::number(list.at(i)->getUx())));
         model->setItem(i, 5, new QStandardItem(QString::number(list.at(i)->getUy())));
+        if (showEnvelope) { // min/max over all load-combinations
+            const Node::ResultEnvelope &envelope = list.at(i)->getResultEnvelope();
+            model->setItem(i, 6, new QStandardItem(QString::number(envelope.minUx)));
+            model->setItem(i, 7, new QStandardItem(QString::number(envelope.maxUx)));
+            model->setItem(i, 8, new QStandardItem(QString::number(envelope.minUy)));
+            model->setItem(i, 9, new QStandardItem(QString::number(envelope.maxUy)));
+        }
     }
 }
 
 void SystemDefinitionDialog::populateModel(QStandardItemModel *model, QList<Rod *> list)
 {
+    rods = list; // the rows of the model, used to write edits back in rodItemChanged()
     for (int i = 0; i < list.length(); i++) {
         model->setItem(i, 0, new QStandardItem(list.at(i)->getId()));
         model->setItem(i, 1, new QStandardItem(list.at(i)->getNode1()->getId()));
@@ -63,13 +87,21 @@ void SystemDefinitionDialog::populateModel(QStandardItemModel *model, QList<Rod
         model->setItem(i, 3, new QStandardItem(QString::number(list.at(i)->getE())));
         model->setItem(i, 4, new QStandardItem(QString::number(list.at(i)->getA())));
         model->setItem(i, 5, new QStandardItem(QString::number(list.at(i)->getI())));
-        model->setItem(i, 6, new QStandardItem(QString::number(list.at(i)->getInnerForce())));
-        model->setItem(i, 7, new QStandardItem(QString::number(list.at(i)->getU(4))));
-        model->setItem(i, 8, new QStandardItem(QString::number(list.at(i)->getU(0))));
-        model->setItem(i, 9, new QStandardItem(QString::number(list.at(i)->getU(1))));
-        model->setItem(i, 10, new QStandardItem(QString::number(list.at(i)->getU(5))));
-        model->setItem(i, 11, new QStandardItem(QString::number(list.at(i)->getU(2))));
-        model->setItem(i, 12, new QStandardItem(QString::number(list.at(i)->getU(3))));
+        model->setItem(i, 6, new QStandardItem(QString::number(list.at(i)->getDensity())));
+        model->setItem(i, 7, new QStandardItem(QString::number(list.at(i)->getInnerForce())));
+        model->setItem(i, 8, new QStandardItem(QString::number(list.at(i)->getU(4))));
+        model->setItem(i, 9, new QStandardItem(QString::number(list.at(i)->getU(0))));
+        model->setItem(i, 10, new QStandardItem(QString::number(list.at(i)->getU(1))));
+        model->setItem(i, 11, new QStandardItem(QString::number(list.at(i)->getU(5))));
+        model->setItem(i, 12, new QStandardItem(QString::number(list.at(i)->getU(2))));
+        model->setItem(i, 13, new QStandardItem(QString::number(list.at(i)->getU(3))));
+        if (showEnvelope) {
+            model->setItem(i, 14, new QStandardItem(QString::number(list.at(i)->getMinInnerForce())));
+            model->setItem(i, 15, new QStandardItem(QString::number(list.at(i)->getMaxInnerForce())));
+        }
+        for (int col = 0; col < model->columnCount(); col++) {
+            model->item(i, col)->setEditable(col == 6); // the density does not change the drawing or the results shown here
+        }
     }
 }
 
@@ -91,6 +123,15 @@ void SystemDefinitionDialog::populateModel(QStandardItemModel *model, QList<Bear
         model->setItem(i, 4, new QStandardItem(QString::number(list.at(i)->getReactionForceX())));
         model->setItem(i, 5, new QStandardItem(QString::number(list.at(i)->getReactionForceY())));
         model->setItem(i, 6, new QStandardItem(QString::number(list.at(i)->getReactionMomentZ())));
+        if (showEnvelope) { // the reactions are the forces of the node, see Bearing::getReactionForceX()
+            const Node::ResultEnvelope &envelope = static_cast<Node *>(list.at(i)->parentItem())->getResultEnvelope();
+            model->setItem(i, 7, new QStandardItem(QString::number(envelope.minFx)));
+            model->setItem(i, 8, new QStandardItem(QString::number(envelope.maxFx)));
+            model->setItem(i, 9, new QStandardItem(QString::number(envelope.minFy)));
+            model->setItem(i, 10, new QStandardItem(QString::number(envelope.maxFy)));
+            model->setItem(i, 11, new QStandardItem(QString::number(envelope.minMz)));
+            model->setItem(i, 12, new QStandardItem(QString::number(envelope.maxMz)));
+        }
     }
 }
 
@@ -132,6 +173,21 @@ void SystemDefinitionDialog::on_tabWidget_currentChanged(int index)
     setMaximumWidth(width + 30);
 }
 
+void SystemDefinitionDialog::rodItemChanged(QStandardItem *item)
+{
+    if (item->column() != 6) {
+        return;
+    }
+    Rod *rod = rods.at(item->row());
+    bool ok;
+    double density = item->text().toDouble(&ok);
+    if (ok && Rod::isValidDensity(density)) {
+        rod->setDensity(density);
+    } else {
+        item->setText(QString::number(rod->getDensity())); // reject the input; this emits itemChanged again, now with a valid number
+    }
+}
+
 void SystemDefinitionDialog::on_okButton_clicked()
 {
     close(); // close dialog on ok-press
@@ -6,6 +6,7 @@
 class GraphicsScene;
 class QTableView;
 class QStandardItemModel;
+class QStandardItem;
 class Node;
 class Rod;
 class Bearing;
@@ -26,6 +27,8 @@ public:
 
 private:
     Ui::SystemDefinitionDialog *ui; // deleted in dtor
+    bool showEnvelope; // true if the scene has load-combinations, then the tables get min/max-columns of the envelope
+    QList<Rod *> rods; // the rods in the order of the rows of the rod-table
 
     void populateModel(QStandardItemModel *model, QList<Node *> list);
     void populateModel(QStandardItemModel *model, QList<Rod *> list);
@@ -38,6 +41,7 @@ private:
     // QWidget interface
 private slots:
     void on_tabWidget_currentChanged(int index);
+    void rodItemChanged(QStandardItem *item);
     void on_okButton_clicked();
 };
 